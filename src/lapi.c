@@ -594,6 +594,27 @@ LUA_API const char *lua_pushlstring (lua_State *L, const char *s, size_t len) {
   return getstr(ts);
 }
 
+/*
+** Pushes a string that uses the memory of 's' (which must have a '\0'
+** at position 'len') without copying it; Lua calls 'falloc(ud, s,
+** len + 1, 0)' (if 'falloc' is not NULL) when it does not need that
+** memory anymore.
+*/
+// 将宿主持有的内存作为字符串压入Lua栈，不拷贝
+LUA_API const char *lua_pushexternalstring (lua_State *L,
+	        const char *s, size_t len, lua_Alloc falloc, void *ud) {
+  TString *ts;
+  lua_lock(L);
+  api_check(L, s[len] == '\0', "string not ending with zero");
+  ts = luaS_newextlstr(L, s, len, falloc, ud);
+  setsvalue2s(L, L->top.p, ts);
+  api_incr_top(L);
+  luaC_checkGC(L);
+  lua_unlock(L);
+  return getstr(ts);
+}
+
+
 // 将一个以零为终止符的字符串指针s压入到栈中。
 LUA_API const char *lua_pushstring (lua_State *L, const char *s) {
   lua_lock(L);
@@ -1195,6 +1216,13 @@ LUA_API int lua_pcallk (lua_State *L, int nargs, int nresults, int errfunc,
   return status;
 }
 
+/*
+** Besides 'b' and 't', 'mode' may be "B": the chunk is binary and every
+** block returned by 'reader' stays unchanged, so functions can point
+** into it (see 'luaU_undump'). If the value on the top of the stack is
+** a string holding those blocks, the loaded functions keep it alive;
+** otherwise the blocks must stay alive while the functions exist.
+*/
 // 加载Lua代码块但不运行
 LUA_API int lua_load (lua_State *L, lua_Reader reader, void *data,
                       const char *chunkname, const char *mode) {
@@ -1296,6 +1324,14 @@ LUA_API int lua_gc (lua_State *L, int what, ...) {
         res = 1;  /* signal it */
       break;
     }
+    case LUA_GCYOUNG: {
+      // 立即执行一次年轻代GC，只在分代模式下有效
+      lu_byte oldstp = g->gcstp;
+      g->gcstp = 0;  /* allow GC to run (GCSTPGC must be zero here) */
+      res = luaC_younggc(L);
+      g->gcstp = oldstp;  /* restore previous state */
+      break;
+    }
     case LUA_GCSETPAUSE: {
       int data = va_arg(argp, int);
       res = getgcparam(g->gcpause);
@@ -1308,6 +1344,13 @@ LUA_API int lua_gc (lua_State *L, int what, ...) {
       setgcparam(g->gcstepmul, data);
       break;
     }
+    case LUA_GCPRECLEAN: {
+      int data = va_arg(argp, int);
+      res = g->gcpreclean;
+      if (data >= 0)  /* else only query it */
+        g->gcpreclean = data;
+      break;
+    }
     case LUA_GCISRUNNING: {
       res = gcrunning(g);
       break;
@@ -13,7 +13,7 @@
 
 
 /* Increments 'L->top.p', checking for stack overflows */
-// ָջĶһ++
+// 指向栈的顶部下一个++
 #define api_incr_top(L)	{L->top.p++; \
 			 api_check(L, L->top.p <= L->ci->top.p, \
 					"stack overflow");}
@@ -24,17 +24,17 @@
 ** stack space to accommodate all results. In this case, this macro
 ** increases its stack space ('L->ci->top.p').
 */
-// жϣ
-// (nres) <= LUA_MULTRETؽnresΪɱ෵ֵʱ
-// L->ci->top.p < L->top.pǰ֡ջָȫջָ루˵÷ջѹ˸෵ֵ
-// ǰ֡ջָ L->ci->top.p ȫջ L->top.p λãչ÷ջռ䡣
+// 条件判断：
+// (nres) <= LUA_MULTRET：当返回结果数量nres为可变多返回值时触发调整。
+// L->ci->top.p < L->top.p：当前调用帧的栈顶指针低于全局栈顶指针（说明被调用方已向栈中压入了更多返回值）。
+// 操作：将当前调用帧的栈顶指针 L->ci->top.p 提升到全局栈顶 L->top.p 的位置，扩展调用方的栈空间。
 #define adjustresults(L,nres) \
     { if ((nres) <= LUA_MULTRET && L->ci->top.p < L->top.p) \
 	L->ci->top.p = L->top.p; }
 
 
 /* Ensure the stack has at least 'n' elements */
-// ȷջҪnԪ
+// 确定栈中至少要有n个元素
 #define api_checknelems(L,n) \
 	api_check(L, (n) < (L->top.p - L->ci->func.p), \
 			  "not enough elements in the stack")
@@ -49,13 +49,13 @@
 ** variables to be closed, have an extra check.
 */
 
-// 鵱ǰǷto-be-closed
+// 检查当前函数是否包含to-be-closed变量
 #define hastocloseCfunc(n)	((n) < LUA_MULTRET)
 
 /* Map [-1, inf) (range of 'nresults') into (-inf, -2] */
-// ӷΧ[-1, inf)ӳ䵽Χ(-inf, -2]
+// 从范围[-1, inf)映射到范围(-inf, -2]
 #define codeNresults(n)		(-(n) - 3)
-// ӷΧ(-inf, -2]ԭʼΧ[-1, inf)
+// 从范围(-inf, -2]解码回原始范围[-1, inf)
 #define decodeNresults(n)	(-(n) - 3)
 
 #endif
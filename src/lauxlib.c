@@ -851,6 +851,89 @@ static int skipcomment (FILE *f, int *cp) {
   else return 0;  /* no comment */
 }
 
+/*
+** When the caller asks for it (a 'B' in the mode of 'luaL_loadfilex'),
+** binary chunks in regular files are mapped into memory and loaded in
+** mode 'B', so that the loader reads them in place and the prototypes
+** can keep pointing into the image. Nested functions and line
+** information are read from the mapping later, on demand, so the file
+** must not be rewritten in place (only replaced, e.g., by a rename)
+** while those functions exist; otherwise the process may get a SIGBUS.
+** This is why mapping is never the default. The image is an external
+** string (the zeros that fill the last page after the end of the file
+** give its ending '\0'), on the top of the stack during the load, so
+** that the prototypes keep it alive; the string collector unmaps it
+** after they are gone. Returns 0 (and leaves the stack as it was) when the
+** file cannot be mapped, so that the caller reads it with stdio.
+*/
+#if defined(LUA_USE_POSIX)	/* { */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* smaller files are cheaper to read (and must not become short strings) */
+#if !defined(LUAL_MINMAPPED)
+#define LUAL_MINMAPPED	1024
+#endif
+
+
+typedef struct LoadM {
+  const char *p;  /* chunk image */
+  size_t size;  /* its size (0 after it was read) */
+} LoadM;
+
+
+/* reader for mode 'B': gives the whole image as a single block */
+static const char *getM (lua_State *L, void *ud, size_t *size) {
+  LoadM *lm = (LoadM *)ud;
+  (void)L;  /* not used */
+  if (lm->size == 0) return NULL;
+  *size = lm->size;
+  lm->size = 0;
+  return lm->p;
+}
+
+
+static void *unmapchunk (void *ud, void *ptr, size_t osize, size_t nsize) {
+  (void)ud; (void)nsize;
+  munmap(ptr, osize - 1);  /* 'osize' counts the ending '\0' */
+  return NULL;
+}
+
+
+// 以内存映射方式加载二进制chunk
+static int loadmapped (lua_State *L, FILE *f, int *status) {
+  struct stat st;
+  long off = ftell(f) - 1;  /* chunk starts at the last character read */
+  size_t size;
+  char *p;
+  LoadM lm;
+  if (off < 0 || fstat(fileno(f), &st) != 0 || !S_ISREG(st.st_mode) ||
+      st.st_size <= off)
+    return 0;
+  size = (size_t)st.st_size;
+  if (size < LUAL_MINMAPPED || size % (size_t)sysconf(_SC_PAGESIZE) == 0)
+    return 0;  /* too small, or no room for the ending '\0' */
+  p = (char *)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+  if (p == MAP_FAILED)
+    return 0;
+  lua_pushexternalstring(L, p, size, unmapchunk, NULL);
+  lm.p = p + off;
+  lm.size = size - off;
+  *status = lua_load(L, getM, &lm, lua_tostring(L, -2), "B");
+  lua_remove(L, -2);  /* remove image from the stack */
+  return 1;
+}
+
+#else				/* }{ */
+
+#define loadmapped(L,f,st)	0
+
+#endif				/* } */
+
+
 // 将一个文件加载为Lua代码块
 // 和lua_load一样，此函数只是加载代码块而不运行
 LUALIB_API int luaL_loadfilex (lua_State *L, const char *filename,
@@ -859,6 +942,9 @@ LUALIB_API int luaL_loadfilex (lua_State *L, const char *filename,
   int status, readstatus;
   int c;
   int fnameindex = lua_gettop(L) + 1;  /* index of filename on the stack */
+  int mapped = (mode != NULL && strchr(mode, 'B') != NULL);
+  if (mapped)  /* stdio buffers are not fixed */
+    mode = (strchr(mode, 't') != NULL) ? "bt" : "b";
   if (filename == NULL) {
     lua_pushliteral(L, "=stdin");
     lf.f = stdin;
@@ -874,6 +960,11 @@ LUALIB_API int luaL_loadfilex (lua_State *L, const char *filename,
     lf.buff[lf.n++] = '\n';  /* add newline to correct line numbers */
   if (c == LUA_SIGNATURE[0]) {  /* binary file? */
     lf.n = 0;  /* remove possible newline */
+    if (filename && mapped && loadmapped(L, lf.f, &status)) {
+      fclose(lf.f);
+      lua_remove(L, fnameindex);
+      return status;
+    }
     if (filename) {  /* "real" file? */
       errno = 0;
       lf.f = freopen(filename, "rb", lf.f);  /* reopen in binary mode */
@@ -1125,6 +1216,357 @@ LUALIB_API const char *luaL_gsub (lua_State *L, const char *s,
 }
 
 
+/*
+** {======================================================
+** Copying values between states
+** =======================================================
+*/
+
+/*
+** 'luaL_xcopy' pushes onto 'to' a deep copy of the value at index 'idx'
+** in 'from'; the two states may belong to different global states,
+** but neither can be running on another thread during the copy.
+** Tables are copied with their raw contents (metatables are not
+** copied) keeping shared and cyclic references; strings, numbers,
+** booleans, light userdata and C functions without upvalues are copied
+** as values. Any other value is an error, raised in 'from'. The copy
+** runs in protected mode in 'to', so a memory error there does not
+** escape; 'from' is only read, and its stack is restored on errors.
+*/
+
+#define XCOPYSEEN	1	/* index in 'to' of table of copied tables */
+#define MAXXCOPYLEVEL	200	/* limit for nested tables */
+
+typedef struct XCopy {
+  lua_State *from;
+  int idx;
+} XCopy;
+
+
+static void xcopyvalue (lua_State *from, int idx, lua_State *to, int level);
+
+
+static void xcopytable (lua_State *from, int idx, lua_State *to,
+                                                  int level) {
+  const void *p = lua_topointer(from, idx);
+  if (lua_rawgetp(to, XCOPYSEEN, p) != LUA_TNIL)  /* already copied? */
+    return;  /* use that copy */
+  lua_pop(to, 1);
+  if (level >= MAXXCOPYLEVEL)
+    luaL_error(to, "too many nested tables to copy");
+  if (!lua_checkstack(from, 2))
+    luaL_error(to, "stack overflow copying table");
+  luaL_checkstack(to, 4, "copying table");
+  lua_createtable(to, (int)lua_rawlen(from, idx), 0);
+  lua_pushvalue(to, -1);
+  lua_rawsetp(to, XCOPYSEEN, p);  /* register table before its contents */
+  lua_pushnil(from);  /* first key */
+  while (lua_next(from, idx)) {
+    xcopyvalue(from, -2, to, level + 1);  /* key */
+    xcopyvalue(from, -1, to, level + 1);  /* value */
+    lua_rawset(to, -3);
+    lua_pop(from, 1);  /* remove value, keep key for next iteration */
+  }
+}
+
+
+static void xcopyvalue (lua_State *from, int idx, lua_State *to, int level) {
+  idx = lua_absindex(from, idx);
+  switch (lua_type(from, idx)) {
+    case LUA_TNIL:
+      lua_pushnil(to);
+      break;
+    case LUA_TBOOLEAN:
+      lua_pushboolean(to, lua_toboolean(from, idx));
+      break;
+    case LUA_TNUMBER:
+      if (lua_isinteger(from, idx))
+        lua_pushinteger(to, lua_tointeger(from, idx));
+      else
+        lua_pushnumber(to, lua_tonumber(from, idx));
+      break;
+    case LUA_TSTRING: {
+      size_t l;
+      const char *s = lua_tolstring(from, idx, &l);
+      lua_pushlstring(to, s, l);
+      break;
+    }
+    case LUA_TLIGHTUSERDATA:
+      lua_pushlightuserdata(to, lua_touserdata(from, idx));
+      break;
+    case LUA_TTABLE:
+      xcopytable(from, idx, to, level);
+      break;
+    case LUA_TFUNCTION: {
+      lua_CFunction f = lua_tocfunction(from, idx);
+      if (f != NULL && lua_getupvalue(from, idx, 1) == NULL) {
+        lua_pushcfunction(to, f);  /* light C function: just copy it */
+        break;
+      }
+      /* else go through */
+    }  /* FALLTHROUGH */
+    default:
+      luaL_error(to, "cannot copy a %s value", luaL_typename(from, idx));
+  }
+}
+
+
+static int xcopy_aux (lua_State *to) {
+  XCopy *x = (XCopy *)lua_touserdata(to, 1);
+  lua_newtable(to);  /* table of copied tables */
+  lua_replace(to, XCOPYSEEN);
+  xcopyvalue(x->from, x->idx, to, 0);
+  return 1;
+}
+
+
+/*
+** Copy the value at index 'idx' in 'from' to the top of 'to' without
+** raising errors. On errors, returns the status with the error message
+** on the top of 'to', or LUA_ERRERR with nothing pushed when 'to' has
+** no stack space; 'from' is left as it was.
+*/
+static int xcopy (lua_State *from, int idx, lua_State *to) {
+  XCopy x;
+  int top = lua_gettop(from);
+  int status;
+  x.from = from;
+  x.idx = lua_absindex(from, idx);
+  if (!lua_checkstack(to, 2))
+    return LUA_ERRERR;
+  lua_pushcfunction(to, xcopy_aux);
+  lua_pushlightuserdata(to, &x);
+  status = lua_pcall(to, 1, 1, 0);
+  if (l_unlikely(status != LUA_OK))
+    lua_settop(from, top);  /* remove keys left by 'lua_next' */
+  return status;
+}
+
+
+/* error message of a failed 'xcopy' into 'to' with status 'status' */
+static const char *xcopymsg (lua_State *to, int status) {
+  if (status == LUA_ERRERR)
+    return "stack overflow copying value";
+  else if (lua_type(to, -1) == LUA_TSTRING)
+    return lua_tostring(to, -1);
+  else
+    return "error copying value";
+}
+
+
+// 把from状态机idx处的值深拷贝一份压入to状态机的栈顶，两个状态机可以属于不同的全局状态
+LUALIB_API void luaL_xcopy (lua_State *from, int idx, lua_State *to) {
+  int status = xcopy(from, idx, to);
+  if (l_unlikely(status != LUA_OK)) {
+    lua_pushstring(from, xcopymsg(to, status));
+    if (status != LUA_ERRERR)
+      lua_pop(to, 1);  /* remove error message */
+    lua_error(from);
+  }
+}
+
+
+/*
+** {------------------------------------------------------
+** Message queues between states
+**
+** A queue holds copies of values sent by 'luaL_enqueue' until some
+** state takes them with 'luaL_dequeue'. The copies live in a private
+** state of the queue (in a ring buffer, the table at index 1 of its
+** stack), so a message is copied twice: into the queue and out of it.
+** Neither copy goes through a serialized form, and the sender and the
+** receiver may belong to different global states running on different
+** threads. With LUA_USE_PTHREADS, a mutex makes the queue safe for any
+** number of senders and receivers, and 'luaL_dequeue' can wait for a
+** message. Otherwise, a queue can only be used by one thread at a time
+** and 'luaL_dequeue' never waits.
+** -------------------------------------------------------
+*/
+
+#if defined(LUA_USE_PTHREADS)
+
+#include <pthread.h>
+
+#define lockqueue(q)	pthread_mutex_lock(&(q)->lock)
+#define unlockqueue(q)	pthread_mutex_unlock(&(q)->lock)
+#define waitqueue(q)	pthread_cond_wait(&(q)->nonempty, &(q)->lock)
+#define signalqueue(q)	pthread_cond_signal(&(q)->nonempty)
+
+#else
+
+#define lockqueue(q)	((void)(q))
+#define unlockqueue(q)	((void)(q))
+#define signalqueue(q)	((void)(q))
+
+#endif
+
+
+#define QUEUEMINSIZE	16	/* initial size of the ring buffer */
+
+struct luaL_Queue {
+  lua_State *Q;  /* private state holding the messages */
+  int head;  /* index in the ring of the first message (from 0) */
+  int n;  /* number of messages */
+  int size;  /* size of the ring */
+#if defined(LUA_USE_PTHREADS)
+  pthread_mutex_t lock;
+  pthread_cond_t nonempty;
+#endif
+};
+
+
+static int newring (lua_State *Q) {
+  lua_createtable(Q, (int)lua_tointeger(Q, 1), 0);
+  return 1;
+}
+
+
+/*
+** Double the size of the ring of 'q', keeping the order of the
+** messages. Returns 0 if there is no memory for it.
+*/
+static int growring (luaL_Queue *q) {
+  lua_State *Q = q->Q;
+  int i;
+  if (q->size >= INT_MAX / 2)
+    return 0;
+  lua_pushcfunction(Q, newring);
+  lua_pushinteger(Q, 2 * q->size);
+  if (lua_pcall(Q, 1, 1, 0) != LUA_OK) {
+    lua_pop(Q, 1);  /* remove error message */
+    return 0;
+  }
+  for (i = 0; i < q->n; i++) {  /* move messages to the new ring */
+    lua_rawgeti(Q, 1, (q->head + i) % q->size + 1);
+    lua_rawseti(Q, 2, i + 1);  /* (table has room: no errors) */
+  }
+  lua_replace(Q, 1);
+  q->head = 0;
+  q->size *= 2;
+  return 1;
+}
+
+
+// 创建一个消息队列，失败时返回NULL
+LUALIB_API luaL_Queue *luaL_newqueue (void) {
+  luaL_Queue *q = (luaL_Queue *)malloc(sizeof(luaL_Queue));
+  if (q == NULL)
+    return NULL;
+  q->Q = luaL_newstate();
+  if (q->Q == NULL) {
+    free(q);
+    return NULL;
+  }
+  lua_pushcfunction(q->Q, newring);
+  lua_pushinteger(q->Q, QUEUEMINSIZE);
+  if (lua_pcall(q->Q, 1, 1, 0) != LUA_OK) {
+    lua_close(q->Q);
+    free(q);
+    return NULL;
+  }
+  q->head = q->n = 0;
+  q->size = QUEUEMINSIZE;
+#if defined(LUA_USE_PTHREADS)
+  if (pthread_mutex_init(&q->lock, NULL) != 0) {
+    lua_close(q->Q);
+    free(q);
+    return NULL;
+  }
+  if (pthread_cond_init(&q->nonempty, NULL) != 0) {
+    pthread_mutex_destroy(&q->lock);
+    lua_close(q->Q);
+    free(q);
+    return NULL;
+  }
+#endif
+  return q;
+}
+
+
+/* frees queue 'q' and the messages still in it; nobody may be using it */
+LUALIB_API void luaL_closequeue (luaL_Queue *q) {
+#if defined(LUA_USE_PTHREADS)
+  pthread_cond_destroy(&q->nonempty);
+  pthread_mutex_destroy(&q->lock);
+#endif
+  lua_close(q->Q);
+  free(q);
+}
+
+
+/*
+** Errors are raised only after the queue is unlocked; so, nothing that
+** may raise an error in the caller's state runs while holding the lock.
+*/
+// 把L中idx处的值拷贝一份放入队列q的尾部，拷贝失败时在L中抛出错误
+LUALIB_API void luaL_enqueue (lua_State *L, int idx, luaL_Queue *q) {
+  char msg[LUAL_BUFFERSIZE];
+  int status;
+  idx = lua_absindex(L, idx);
+  lockqueue(q);
+  if (q->n == q->size && !growring(q)) {
+    unlockqueue(q);
+    luaL_error(L, "not enough memory for queue");
+  }
+  status = xcopy(L, idx, q->Q);
+  if (status == LUA_OK) {
+    lua_rawseti(q->Q, 1, (q->head + q->n) % q->size + 1);
+    q->n++;
+    signalqueue(q);
+  }
+  else {  /* keep the message out of the queue's state */
+    strncpy(msg, xcopymsg(q->Q, status), sizeof(msg) - 1);
+    msg[sizeof(msg) - 1] = '\0';
+    if (status != LUA_ERRERR)
+      lua_pop(q->Q, 1);
+  }
+  unlockqueue(q);
+  if (l_unlikely(status != LUA_OK))
+    luaL_error(L, "%s", msg);
+}
+
+
+/*
+** Pushes onto 'L' a copy of the first message in queue 'q' and removes
+** it from the queue. If the queue is empty, waits for a message when
+** 'wait' is true (and the queue can wait); otherwise returns 0 without
+** pushing anything. Returns 1 when it pushes a message.
+*/
+LUALIB_API int luaL_dequeue (lua_State *L, luaL_Queue *q, int wait) {
+  int status;
+  lockqueue(q);
+#if defined(LUA_USE_PTHREADS)
+  while (q->n == 0 && wait)
+    waitqueue(q);
+#else
+  (void)wait;  /* no other thread could fill the queue */
+#endif
+  if (q->n == 0) {
+    unlockqueue(q);
+    return 0;
+  }
+  lua_rawgeti(q->Q, 1, q->head + 1);
+  status = xcopy(q->Q, -1, L);  /* (errors leave their message in 'L') */
+  lua_pop(q->Q, 1);
+  if (status == LUA_OK) {  /* else message stays in the queue */
+    lua_pushnil(q->Q);
+    lua_rawseti(q->Q, 1, q->head + 1);  /* release the queue's copy */
+    q->head = (q->head + 1) % q->size;
+    q->n--;
+  }
+  unlockqueue(q);
+  if (l_unlikely(status == LUA_ERRERR))
+    luaL_error(L, "%s", xcopymsg(L, status));
+  else if (l_unlikely(status != LUA_OK))
+    lua_error(L);
+  return 1;
+}
+
+/* }------------------------------------------------------ */
+
+/* }====================================================== */
+
+
 
 // 尝试重新调整之前调用realloc所分配的ptr所指向的内存块的大小。
 // ud - 目前没有用到
@@ -1144,6 +1586,397 @@ static void *l_alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
 }
 
 
+/*
+** {======================================================
+** Background freeing
+** =======================================================
+*/
+
+/*
+** An allocator that hands the blocks released by the collector's sweep
+** (and every other free) to a background thread, in batches of BGBATCH
+** blocks, so that the mutator does not pay for 'free'. There are two
+** batch buffers: the mutator fills one while the thread empties the
+** other; a mutator with a full buffer waits for the thread to finish
+** the previous batch, which bounds the memory waiting to be freed.
+** Lua has no hook to tell an allocator that its state is gone, so the
+** allocator remembers the first block it allocates, which 'lua_newstate'
+** uses for the state itself and 'lua_close' frees last; freeing that
+** block flushes the pending frees, stops the thread and releases the
+** allocator (as does a failure to allocate that first block).
+*/
+#if defined(LUA_USE_PTHREADS)
+
+#include <pthread.h>
+
+#if !defined(BGBATCH)
+#define BGBATCH		4096
+#endif
+
+typedef struct BgFree {
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  pthread_t thread;
+  void *stateblock;  /* block holding the Lua state */
+  void **cur;  /* batch being filled by the mutator */
+  int ncur;  /* number of blocks in 'cur' */
+  void **handed;  /* batch given to the thread (NULL if none) */
+  void **spare;  /* empty batch (NULL while the thread owns it) */
+  int stop;  /* true when the thread must exit */
+  void *buff[2][BGBATCH];
+} BgFree;
+
+
+static void *bgfree_thread (void *arg) {
+  BgFree *b = (BgFree *)arg;
+  pthread_mutex_lock(&b->lock);
+  for (;;) {
+    void **batch;
+    int i;
+    while (b->handed == NULL && !b->stop)
+      pthread_cond_wait(&b->cond, &b->lock);
+    if (b->handed == NULL)  /* stopped and nothing to free? */
+      break;
+    batch = b->handed;
+    pthread_mutex_unlock(&b->lock);
+    for (i = 0; i < BGBATCH; i++)
+      free(batch[i]);
+    pthread_mutex_lock(&b->lock);
+    b->handed = NULL;
+    b->spare = batch;
+    pthread_cond_broadcast(&b->cond);  /* wake up a waiting mutator */
+  }
+  pthread_mutex_unlock(&b->lock);
+  return NULL;
+}
+
+
+/*
+** Give the current (full) batch to the thread and take the spare one.
+*/
+static void bgfree_handoff (BgFree *b) {
+  pthread_mutex_lock(&b->lock);
+  while (b->handed != NULL)  /* thread still busy with previous batch? */
+    pthread_cond_wait(&b->cond, &b->lock);
+  b->handed = b->cur;
+  b->cur = b->spare;
+  b->spare = NULL;
+  b->ncur = 0;
+  pthread_cond_broadcast(&b->cond);
+  pthread_mutex_unlock(&b->lock);
+}
+
+
+static void bgfree_close (BgFree *b) {
+  int i;
+  pthread_mutex_lock(&b->lock);
+  b->stop = 1;
+  pthread_cond_broadcast(&b->cond);
+  pthread_mutex_unlock(&b->lock);
+  pthread_join(b->thread, NULL);  /* thread frees the handed batch */
+  for (i = 0; i < b->ncur; i++)
+    free(b->cur[i]);
+  pthread_cond_destroy(&b->cond);
+  pthread_mutex_destroy(&b->lock);
+  free(b);
+}
+
+
+static void *bgfree_alloc (void *ud, void *ptr, size_t osize,
+                                               size_t nsize) {
+  BgFree *b = (BgFree *)ud;
+  (void)osize;  /* not used */
+  if (nsize == 0) {
+    if (ptr == b->stateblock) {  /* closing the state? */
+      free(ptr);
+      bgfree_close(b);
+    }
+    else if (ptr != NULL) {
+      b->cur[b->ncur++] = ptr;
+      if (b->ncur == BGBATCH)
+        bgfree_handoff(b);
+    }
+    return NULL;
+  }
+  else {
+    void *newblock = realloc(ptr, nsize);
+    if (b->stateblock == NULL) {  /* first allocation? */
+      b->stateblock = newblock;  /* it is the state */
+      if (newblock == NULL)  /* 'lua_newstate' will fail? */
+        bgfree_close(b);
+    }
+    return newblock;
+  }
+}
+
+
+static lua_State *bgfree_newstate (void) {
+  BgFree *b = (BgFree *)malloc(sizeof(BgFree));
+  if (b == NULL)
+    return NULL;
+  b->stateblock = NULL;
+  b->cur = b->buff[0];
+  b->spare = b->buff[1];
+  b->handed = NULL;
+  b->ncur = 0;
+  b->stop = 0;
+  if (pthread_mutex_init(&b->lock, NULL) != 0) {
+    free(b);
+    return NULL;
+  }
+  if (pthread_cond_init(&b->cond, NULL) != 0) {
+    pthread_mutex_destroy(&b->lock);
+    free(b);
+    return NULL;
+  }
+  if (pthread_create(&b->thread, NULL, bgfree_thread, b) != 0) {
+    pthread_cond_destroy(&b->cond);
+    pthread_mutex_destroy(&b->lock);
+    free(b);
+    return NULL;
+  }
+  return lua_newstate(bgfree_alloc, b);  /* allocator owns 'b' now */
+}
+
+#else				/* }{ */
+
+#define bgfree_newstate()	lua_newstate(l_alloc, NULL)
+
+#endif				/* } */
+
+/* }====================================================== */
+
+
+/*
+** {======================================================
+** Slab allocator
+** =======================================================
+*/
+
+/*
+** Blocks of up to SLABMAX bytes (strings, tables, closures, upvalues,
+** small vectors) come from pages of SLABPAGE bytes, each page serving a
+** single size class (multiples of SLABGRAIN). Pages are aligned to their
+** size, so the page of a block is found by masking its address. Lua
+** always gives the allocator the size of a block, so a block is in a
+** page iff that size is at most SLABMAX; larger blocks use 'realloc'.
+** A page whose blocks are all free goes back to the system, unless it
+** is the only page with free slots in its class.
+** As with the background allocator, the first block allocated is the
+** state, and freeing it releases the allocator.
+*/
+#if defined(LUA_USE_POSIX) || defined(_WIN32)
+
+#if !defined(SLABPAGE)
+#define SLABPAGE	16384	/* must be a power of 2 */
+#endif
+
+#define SLABGRAIN	16
+#define SLABMAX		256
+#define NSLABCLASS	(SLABMAX / SLABGRAIN)
+
+/* size class for a block of 'sz' bytes (0 < sz <= SLABMAX) */
+#define slabclass(sz)	(((sz) - 1) / SLABGRAIN)
+#define classsize(c)	(((c) + 1) * SLABGRAIN)
+
+typedef struct SlabPage {
+  struct SlabPage *prev, *next;  /* pages of the class with free slots */
+  void *freeslots;  /* list of freed slots */
+  char *top;  /* first slot never used */
+  unsigned int nused;  /* number of slots in use */
+  unsigned int cls;  /* size class of the page */
+} SlabPage;
+
+/* offset of the first slot (keeps slots aligned to SLABGRAIN) */
+#define SLABHEADER  \
+	((sizeof(SlabPage) + SLABGRAIN - 1) / SLABGRAIN * SLABGRAIN)
+
+#define pageof(b)	((SlabPage *)((size_t)(b) & ~((size_t)SLABPAGE - 1)))
+
+#if defined(LUA_USE_POSIX)
+
+static void *slab_pagealloc (void) {
+  void *p;
+  return (posix_memalign(&p, SLABPAGE, SLABPAGE) == 0) ? p : NULL;
+}
+
+#define slab_pagefree(p)	free(p)
+
+#else
+
+#include <malloc.h>
+
+#define slab_pagealloc()	_aligned_malloc(SLABPAGE, SLABPAGE)
+#define slab_pagefree(p)	_aligned_free(p)
+
+#endif
+
+typedef struct Slab {
+  void *stateblock;  /* block holding the Lua state */
+  SlabPage *partial[NSLABCLASS];  /* pages with free slots, per class */
+} Slab;
+
+
+static void slab_unlink (Slab *s, SlabPage *p) {
+  if (p->prev) p->prev->next = p->next;
+  else s->partial[p->cls] = p->next;
+  if (p->next) p->next->prev = p->prev;
+}
+
+
+static void slab_link (Slab *s, SlabPage *p) {
+  p->prev = NULL;
+  p->next = s->partial[p->cls];
+  if (p->next) p->next->prev = p;
+  s->partial[p->cls] = p;
+}
+
+
+static int slab_isfull (SlabPage *p) {
+  return (p->freeslots == NULL &&
+          p->top + classsize(p->cls) > (char *)p + SLABPAGE);
+}
+
+
+static void *slab_get (Slab *s, size_t sz) {
+  unsigned int c = (unsigned int)slabclass(sz);
+  SlabPage *p = s->partial[c];
+  void *b;
+  if (p == NULL) {  /* no page with free slots? */
+    p = (SlabPage *)slab_pagealloc();
+    if (p == NULL)
+      return NULL;
+    p->freeslots = NULL;
+    p->top = (char *)p + SLABHEADER;
+    p->nused = 0;
+    p->cls = c;
+    slab_link(s, p);
+  }
+  if (p->freeslots != NULL) {  /* reuse a freed slot */
+    b = p->freeslots;
+    p->freeslots = *(void **)b;
+  }
+  else {  /* take a new slot */
+    b = p->top;
+    p->top += classsize(c);
+  }
+  p->nused++;
+  if (slab_isfull(p))
+    slab_unlink(s, p);
+  return b;
+}
+
+
+static void slab_put (Slab *s, void *b) {
+  SlabPage *p = pageof(b);
+  if (slab_isfull(p))  /* page will have a free slot again? */
+    slab_link(s, p);
+  *(void **)b = p->freeslots;
+  p->freeslots = b;
+  if (--p->nused == 0 && (p->prev != NULL || p->next != NULL)) {
+    slab_unlink(s, p);  /* empty and not the only page of its class */
+    slab_pagefree(p);
+  }
+}
+
+
+static void slab_close (Slab *s) {
+  int c;
+  for (c = 0; c < NSLABCLASS; c++) {
+    SlabPage *p = s->partial[c];
+    while (p != NULL) {  /* free cached pages */
+      SlabPage *next = p->next;
+      slab_pagefree(p);
+      p = next;
+    }
+  }
+  free(s);
+}
+
+
+/*
+** Move a block between a page and 'realloc' or between two size
+** classes. When shrinking inside a page fails, the block stays in
+** its (larger) slot, which is still freed through its page.
+*/
+static void *slab_move (Slab *s, void *ptr, size_t osize, size_t nsize) {
+  void *newblock;
+  if (nsize <= SLABMAX) {
+    newblock = slab_get(s, nsize);
+    if (newblock == NULL)
+      return (osize <= SLABMAX && nsize < osize) ? ptr : NULL;
+  }
+  else {
+    newblock = malloc(nsize);
+    if (newblock == NULL)
+      return NULL;
+  }
+  memcpy(newblock, ptr, (osize < nsize) ? osize : nsize);
+  if (osize <= SLABMAX)
+    slab_put(s, ptr);
+  else
+    free(ptr);
+  return newblock;
+}
+
+
+static void *slab_alloc (void *ud, void *ptr, size_t osize, size_t nsize) {
+  Slab *s = (Slab *)ud;
+  if (nsize == 0) {
+    if (ptr == s->stateblock) {  /* closing the state? */
+      free(ptr);
+      slab_close(s);
+    }
+    else if (ptr != NULL) {
+      if (osize <= SLABMAX)
+        slab_put(s, ptr);
+      else
+        free(ptr);
+    }
+    return NULL;
+  }
+  else if (ptr == NULL) {  /* new block ('osize' is a tag) */
+    void *newblock;
+    if (s->stateblock == NULL) {  /* first allocation? */
+      newblock = malloc(nsize);
+      s->stateblock = newblock;  /* it is the state */
+      if (newblock == NULL)  /* 'lua_newstate' will fail? */
+        slab_close(s);
+    }
+    else
+      newblock = (nsize <= SLABMAX) ? slab_get(s, nsize) : malloc(nsize);
+    return newblock;
+  }
+  else if (osize > SLABMAX && nsize > SLABMAX)
+    return realloc(ptr, nsize);
+  else if (osize <= SLABMAX && nsize <= SLABMAX &&
+           pageof(ptr)->cls == slabclass(nsize))
+    return ptr;  /* same size class */
+  else
+    return slab_move(s, ptr, osize, nsize);
+}
+
+
+static lua_State *slab_newstate (void) {
+  int c;
+  Slab *s = (Slab *)malloc(sizeof(Slab));
+  if (s == NULL)
+    return NULL;
+  s->stateblock = NULL;
+  for (c = 0; c < NSLABCLASS; c++)
+    s->partial[c] = NULL;
+  return lua_newstate(slab_alloc, s);  /* allocator owns 's' now */
+}
+
+#else				/* }{ */
+
+#define slab_newstate()	lua_newstate(l_alloc, NULL)
+
+#endif				/* } */
+
+/* }====================================================== */
+
+
 /*
 ** Standard panic funcion just prints an error message. The test
 ** with 'lua_type' avoids possible memory errors in 'lua_tostring'.
@@ -1218,7 +2051,16 @@ static void warnfon (void *ud, const char *message, int tocont) {
 
 // 创建一个状态机
 LUALIB_API lua_State *luaL_newstate (void) {
-  lua_State *L = lua_newstate(l_alloc, NULL);
+  return luaL_newstateex(0);
+}
+
+
+// 按选项创建一个状态机，LUAL_BGFREE表示内存块由后台线程释放，
+// LUAL_SLABALLOC表示小内存块按大小分级从页中分配（优先于LUAL_BGFREE）
+LUALIB_API lua_State *luaL_newstateex (int opts) {
+  lua_State *L = (opts & LUAL_SLABALLOC) ? slab_newstate()
+               : (opts & LUAL_BGFREE) ? bgfree_newstate()
+               : lua_newstate(l_alloc, NULL);
   if (l_likely(L)) {
     lua_atpanic(L, &panic);
     lua_setwarnf(L, warnfoff, L);  /* default is warnings off */
@@ -1237,3 +2079,206 @@ LUALIB_API void luaL_checkversion_ (lua_State *L, lua_Number ver, size_t sz) {
                   (LUAI_UACNUMBER)ver, (LUAI_UACNUMBER)v);
 }
 
+
+
+/*
+** {======================================================
+** Compiling files in parallel
+** =======================================================
+*/
+
+/*
+** 'luaL_loadfiles' compiles a batch of files on up to
+** LUAL_COMPILETHREADS threads (the caller included). Each file is
+** compiled in a scratch state of its own and dumped; the target state
+** then loads the dumps, which is much cheaper than parsing. (Prototypes
+** cannot move between states, as their strings belong to their state.)
+** The jobs live in a userdata with a finalizer, so that the dumps are
+** released even if loading them raises an error.
+*/
+
+#if !defined(LUAL_COMPILETHREADS)
+#define LUAL_COMPILETHREADS	4
+#endif
+
+#define COMPILEJOBS	"_COMPILEJOBS"
+
+typedef struct CompileJob {
+  const char *fname;  /* file to compile */
+  const char *mode;
+  char *buff;  /* dumped chunk or error message */
+  size_t size;  /* size of the contents of 'buff' */
+  size_t cap;  /* size of 'buff' */
+  int status;  /* result of the compilation */
+} CompileJob;
+
+
+typedef struct CompileBatch {
+  CompileJob *jobs;
+  int n;  /* number of jobs */
+  int next;  /* next job to be taken */
+#if defined(LUA_USE_PTHREADS)
+  pthread_mutex_t lock;
+#endif
+} CompileBatch;
+
+
+static int jobwriter (lua_State *L, const void *p, size_t sz, void *ud) {
+  CompileJob *j = (CompileJob *)ud;
+  (void)L;  /* not used */
+  if (j->cap - j->size < sz) {  /* must grow buffer? */
+    size_t ncap = (j->cap == 0) ? 1024 : j->cap * 2;
+    char *nb;
+    while (ncap - j->size < sz)
+      ncap *= 2;
+    nb = (char *)realloc(j->buff, ncap);
+    if (nb == NULL)
+      return 1;
+    j->buff = nb;
+    j->cap = ncap;
+  }
+  memcpy(j->buff + j->size, p, sz);
+  j->size += sz;
+  return 0;
+}
+
+
+static int compile_aux (lua_State *L) {
+  CompileJob *j = (CompileJob *)lua_touserdata(L, 1);
+  if (luaL_loadfilex(L, j->fname, j->mode) != LUA_OK)
+    return lua_error(L);
+  if (lua_dump(L, jobwriter, j, 0) != 0)
+    return luaL_error(L, "not enough memory");
+  return 0;
+}
+
+
+/* compile a file in a scratch state (runs on any thread) */
+static void compilejob (CompileJob *j) {
+  lua_State *L = luaL_newstate();
+  if (L == NULL) {
+    j->status = LUA_ERRMEM;
+    return;
+  }
+  lua_pushcfunction(L, compile_aux);
+  lua_pushlightuserdata(L, j);
+  j->status = lua_pcall(L, 1, 0, 0);
+  if (j->status != LUA_OK) {  /* keep error message instead of dump */
+    size_t l;
+    const char *msg = lua_tolstring(L, -1, &l);
+    j->size = 0;
+    if (msg != NULL && jobwriter(L, msg, l, j) != 0)
+      j->size = 0;  /* no message */
+  }
+  lua_close(L);
+}
+
+
+#if defined(LUA_USE_PTHREADS)	/* { */
+
+#include <pthread.h>
+
+static CompileJob *nextjob (CompileBatch *b) {
+  CompileJob *j = NULL;
+  pthread_mutex_lock(&b->lock);
+  if (b->next < b->n)
+    j = &b->jobs[b->next++];
+  pthread_mutex_unlock(&b->lock);
+  return j;
+}
+
+
+static void *compile_thread (void *arg) {
+  CompileBatch *b = (CompileBatch *)arg;
+  CompileJob *j;
+  while ((j = nextjob(b)) != NULL)
+    compilejob(j);
+  return NULL;
+}
+
+
+static void runjobs (CompileBatch *b) {
+  pthread_t th[LUAL_COMPILETHREADS];
+  int i, nth = 0;
+  pthread_mutex_init(&b->lock, NULL);
+  for (i = 1; i < LUAL_COMPILETHREADS && i < b->n; i++) {
+    if (pthread_create(&th[nth], NULL, compile_thread, b) != 0)
+      break;  /* go on with the threads we have */
+    nth++;
+  }
+  compile_thread(b);  /* caller works too */
+  for (i = 0; i < nth; i++)
+    pthread_join(th[i], NULL);
+  pthread_mutex_destroy(&b->lock);
+}
+
+#else				/* }{ */
+
+static void runjobs (CompileBatch *b) {
+  for (; b->next < b->n; b->next++)
+    compilejob(&b->jobs[b->next]);
+}
+
+#endif				/* } */
+
+
+static int jobsgc (lua_State *L) {
+  CompileJob *jobs = (CompileJob *)lua_touserdata(L, 1);
+  size_t i, n = lua_rawlen(L, 1) / sizeof(CompileJob);
+  for (i = 0; i < n; i++) {
+    free(jobs[i].buff);
+    jobs[i].buff = NULL;
+  }
+  return 0;
+}
+
+
+// 多线程并行编译一批文件，按顺序把每个文件的函数(或错误信息)压栈，返回失败的个数
+LUALIB_API int luaL_loadfiles (lua_State *L, const char *const *fnames,
+                               int n, const char *mode) {
+  CompileBatch b;
+  int i, jobsidx;
+  int nerr = 0;
+  luaL_checkstack(L, n + 3, "too many files");
+  b.jobs = (CompileJob *)lua_newuserdatauv(L, n * sizeof(CompileJob), 0);
+  b.n = n;
+  b.next = 0;
+  for (i = 0; i < n; i++) {
+    b.jobs[i].fname = fnames[i];
+    b.jobs[i].mode = mode;
+    b.jobs[i].buff = NULL;
+    b.jobs[i].size = b.jobs[i].cap = 0;
+    b.jobs[i].status = LUA_OK;
+  }
+  if (luaL_newmetatable(L, COMPILEJOBS)) {
+    lua_pushcfunction(L, jobsgc);
+    lua_setfield(L, -2, "__gc");
+  }
+  lua_setmetatable(L, -2);
+  jobsidx = lua_gettop(L);
+  runjobs(&b);
+  for (i = 0; i < n; i++) {  /* load results into 'L' */
+    CompileJob *j = &b.jobs[i];
+    if (j->status == LUA_OK) {
+      lua_pushfstring(L, "@%s", j->fname);
+      if (luaL_loadbufferx(L, j->buff, j->size, lua_tostring(L, -1), "b")
+            != LUA_OK)
+        nerr++;
+      lua_remove(L, -2);  /* remove chunk name */
+    }
+    else {
+      if (j->size > 0)
+        lua_pushlstring(L, j->buff, j->size);
+      else
+        lua_pushfstring(L, "cannot compile %s", j->fname);
+      nerr++;
+    }
+    free(j->buff);  /* not needed anymore */
+    j->buff = NULL;
+  }
+  lua_remove(L, jobsidx);
+  return nerr;
+}
+
+/* }====================================================== */
+
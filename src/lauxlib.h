@@ -43,7 +43,7 @@ typedef struct luaL_Reg {
 
 #define LUAL_NUMSIZES	(sizeof(lua_Integer)*16 + sizeof(lua_Number))
 
-// 汾ż
+// 版本号检测
 LUALIB_API void (luaL_checkversion_) (lua_State *L, lua_Number ver, size_t sz);
 #define luaL_checkversion(L)  \
 	  luaL_checkversion_(L, LUA_VERSION_NUM, LUAL_NUMSIZES)
@@ -101,6 +101,13 @@ LUALIB_API int (luaL_loadstring) (lua_State *L, const char *s);
 
 LUALIB_API lua_State *(luaL_newstate) (void);
 
+/* options for 'luaL_newstateex' */
+#define LUAL_BGFREE	1	/* free memory blocks on a background thread */
+#define LUAL_SLABALLOC	2	/* serve small blocks from size-class pages */
+				/* (takes precedence over LUAL_BGFREE) */
+
+LUALIB_API lua_State *(luaL_newstateex) (int opts);
+
 LUALIB_API lua_Integer (luaL_len) (lua_State *L, int idx);
 
 LUALIB_API void (luaL_addgsub) (luaL_Buffer *b, const char *s,
@@ -118,6 +125,19 @@ LUALIB_API void (luaL_traceback) (lua_State *L, lua_State *L1,
 LUALIB_API void (luaL_requiref) (lua_State *L, const char *modname,
                                  lua_CFunction openf, int glb);
 
+LUALIB_API void (luaL_xcopy) (lua_State *from, int idx, lua_State *to);
+
+/* queue of values copied between states (see 'luaL_enqueue') */
+typedef struct luaL_Queue luaL_Queue;
+
+LUALIB_API luaL_Queue *(luaL_newqueue) (void);
+LUALIB_API void (luaL_closequeue) (luaL_Queue *q);
+LUALIB_API void (luaL_enqueue) (lua_State *L, int idx, luaL_Queue *q);
+LUALIB_API int (luaL_dequeue) (lua_State *L, luaL_Queue *q, int wait);
+
+LUALIB_API int (luaL_loadfiles) (lua_State *L, const char *const *fnames,
+                                 int n, const char *mode);
+
 /*
 ** ===============================================================
 ** some useful macros
@@ -125,11 +145,11 @@ LUALIB_API void (luaL_requiref) (lua_State *L, const char *modname,
 */
 
 
-// һluaչtalelһҪעc
+// 创建一个lua扩展tale，l一般是要注册的c函数
 #define luaL_newlibtable(L,l)	\
   lua_createtable(L, 0, sizeof(l)/sizeof((l)[0]) - 1)
 
-// 汾luaչtablelеչõtable
+// 检测版本，创建lua扩展table，将l中的扩展函数设置到table
 #define luaL_newlib(L,l)  \
   (luaL_checkversion(L), luaL_newlibtable(L,l), luaL_setfuncs(L,l,0))
 
@@ -144,15 +164,15 @@ LUALIB_API void (luaL_requiref) (lua_State *L, const char *modname,
 
 #define luaL_typename(L,i)	lua_typename(L, lua_type(L,(i)))
 
-// زִһLuaűļ
+// 加载并执行一个Lua脚本文件
 #define luaL_dofile(L, fn) \
 	(luaL_loadfile(L, fn) || lua_pcall(L, 0, LUA_MULTRET, 0))
 
-// زִһLuaűַ
+// 加载并执行一段Lua脚本字符串
 #define luaL_dostring(L, s) \
 	(luaL_loadstring(L, s) || lua_pcall(L, 0, LUA_MULTRET, 0))
 
-// LuaעлȡָƵԪ
+// 从Lua的注册表中获取指定名称的元表
 #define luaL_getmetatable(L,n)	(lua_getfield(L, LUA_REGISTRYINDEX, (n)))
 
 #define luaL_opt(L,f,n,d)	(lua_isnoneornil(L,(n)) ? (d) : f(L,(n)))
@@ -194,20 +214,20 @@ LUALIB_API void (luaL_requiref) (lua_State *L, const char *modname,
 ** =======================================================
 */
 
-// ַ
+// 字符串缓冲区
 struct luaL_Buffer {
-  // ǰĵַ
+  // 当前缓冲区的地址
   char *b;  /* buffer address */
-  // ǰĴС
+  // 当前缓冲区的大小
   size_t size;  /* buffer size */
-  // ʹõַ
+  // 缓冲区中已使用的字符数
   size_t n;  /* number of characters in buffer */
-  //  Lua ״̬
+  // 关联的 Lua 状态机
   lua_State *L;
   union {
-    // ȷ
+    // 确保缓冲区的最大对齐
     LUAI_MAXALIGN;  /* ensure maximum alignment for buffer */
-    // ʼ
+    // 初始缓冲区
     char b[LUAL_BUFFERSIZE];  /* initial buffer */
   } init;
 };
@@ -129,16 +129,16 @@ static int luaB_error (lua_State *L) {
 // returns the associated value. 
 // Otherwise, returns the metatable of the given object.
 // 
-// 뱣ǵĶʹʹ߼ȿҲ޸metatables
-// ǿԶmetatable__metatableֵ
-// getmetatableֵsetmetatable
+// 假如我们想保护我们的对象使其使用者既看不到也不能修改metatables。
+// 我们可以对metatable设置了__metatable的值，
+// getmetatable将返回这个域的值，而调用setmetatable将会出错
 static int luaB_getmetatable (lua_State *L) {
   luaL_checkany(L, 1);
   if (!lua_getmetatable(L, 1)) {
     lua_pushnil(L);
     return 1;  /* no metatable */
   }
-  // ԪѾ__metatableֱӷضӦûзԪ
+  // 如果元表中已经有了__metatable则直接返回对应对象，如果没有返回元表本身即可
   luaL_getmetafield(L, 1, "__metatable");
   return 1;  /* returns either __metatable field (if present) or metatable */
 }
@@ -151,20 +151,20 @@ static int luaB_getmetatable (lua_State *L) {
 // If the original metatable has a "__metatable" field, raises an error.
 // This function returns table.
 // 
-// 뱣ǵĶʹʹ߼ȿҲ޸metatables
-// ǿԶmetatable__metatableֵgetmetatableֵ
-// setmetatable
+// 假如我们想保护我们的对象使其使用者既看不到也不能修改metatables。
+// 我们可以对metatable设置了__metatable的值，getmetatable将返回这个域的值，
+// 而调用setmetatable将会出错
 static int luaB_setmetatable (lua_State *L) {
-  // Ԫ
+  // 传入的元表
   int t = lua_type(L, 2);
-  // ҪԪĿ
+  // 要设置元表的目标表
   luaL_checktype(L, 1, LUA_TTABLE);
   luaL_argexpected(L, t == LUA_TNIL || t == LUA_TTABLE, 2, "nil or table");
-  // Ԫ__metatableͻᱨ
+  // 元表设置了__metatable，就会报错
   if (l_unlikely(luaL_getmetafield(L, 1, "__metatable") != LUA_TNIL))
     return luaL_error(L, "cannot change a protected metatable");
   lua_settop(L, 2);
-  // Ԫ
+  // 设置元表
   lua_setmetatable(L, 1);
   return 1;
 }
@@ -223,10 +223,10 @@ static int pushmode (lua_State *L, int oldmode) {
 static int luaB_collectgarbage (lua_State *L) {
   static const char *const opts[] = {"stop", "restart", "collect",
     "count", "step", "setpause", "setstepmul",
-    "isrunning", "generational", "incremental", NULL};
+    "isrunning", "generational", "incremental", "young", "preclean", NULL};
   static const int optsnum[] = {LUA_GCSTOP, LUA_GCRESTART, LUA_GCCOLLECT,
     LUA_GCCOUNT, LUA_GCSTEP, LUA_GCSETPAUSE, LUA_GCSETSTEPMUL,
-    LUA_GCISRUNNING, LUA_GCGEN, LUA_GCINC};
+    LUA_GCISRUNNING, LUA_GCGEN, LUA_GCINC, LUA_GCYOUNG, LUA_GCPRECLEAN};
   int o = optsnum[luaL_checkoption(L, 1, "collect", opts)];
   switch (o) {
     case LUA_GCCOUNT: {
@@ -251,7 +251,15 @@ static int luaB_collectgarbage (lua_State *L) {
       lua_pushinteger(L, previous);
       return 1;
     }
-    case LUA_GCISRUNNING: {
+    case LUA_GCPRECLEAN: {
+      int n = (int)luaL_optinteger(L, 2, -1);
+      int previous = lua_gc(L, o, n);
+      checkvalres(previous);
+      lua_pushinteger(L, previous);
+      return 1;
+    }
+    case LUA_GCISRUNNING:
+    case LUA_GCYOUNG: {
       int res = lua_gc(L, o);
       checkvalres(res);
       lua_pushboolean(L, res);
@@ -344,10 +352,10 @@ static int luaB_ipairs (lua_State *L) {
 }
 
 
-// ڴزĽ
+// 用于处理加载操作的结果
 static int load_aux (lua_State *L, int status, int envidx) {
   if (l_likely(status == LUA_OK)) {
-    // ɹڻû
+    // 成功，存在环境表就设置环境表
     if (envidx != 0) {  /* 'env' parameter? */
       lua_pushvalue(L, envidx);  /* environment for loaded function */
       if (!lua_setupvalue(L, -2, 1))  /* set it as 1st upvalue */
@@ -356,7 +364,7 @@ static int load_aux (lua_State *L, int status, int envidx) {
     return 1;
   }
   else {  /* error (message is on top of the stack) */
-    // ʧܣѹһʧܱǣʧܱǲ뵽Ϣ֮ǰջ˳
+    // 失败，压入一个失败标记，将失败标记插入到错误消息之前，调整栈的顺序
     luaL_pushfail(L);
     lua_insert(L, -2);  /* put before error message */
     return 2;  /* return fail plus error message */
@@ -364,7 +372,7 @@ static int load_aux (lua_State *L, int status, int envidx) {
 }
 
 
-// زָLuaļ
+// 加载并编译指定的Lua文件
 static int luaB_loadfile (lua_State *L) {
   const char *fname = luaL_optstring(L, 1, NULL);
   const char *mode = luaL_optstring(L, 2, NULL);
@@ -395,58 +403,60 @@ static int luaB_loadfile (lua_State *L) {
 ** stack top. Instead, it keeps its resulting string in a
 ** reserved slot inside the stack.
 */
-// ͨõĶȡ
+// 通用的读取器函数
 static const char *generic_reader (lua_State *L, void *ud, size_t *size) {
   (void)(ud);  /* not used */
-  // ȷջ㹻Ŀռ䣨2λ
+  // 确保栈中有足够的空间（至少2个槽位）
   luaL_checkstack(L, 2, "too many nested functions");
-  // ջΪ1ֵûṩĶȡѹջ
-  // LuaűݸCģ鷵ش
+  // 栈中索引为1的值（即用户提供的读取器函数）压入栈顶，
+  // 这个函数是由Lua脚本传递给C的，负责逐块返回代码内容
   lua_pushvalue(L, 1);  /* get function */
-  // ȡķֵᱻջ
+  // 读取器函数的返回值会被放置在栈顶
   lua_call(L, 0, 1);  /* call it */
   if (lua_isnil(L, -1)) {
-    // ֵ nilʾûиݿɶ
+    // 如果返回值是 nil，表示没有更多内容可读
     lua_pop(L, 1);  /* pop result */
     *size = 0;
     return NULL;
   }
-  // ֵַͣ׳ʾȡ뷵ַ
+  // 如果返回值不是字符串类型，抛出错误，提示“读取器函数必须返回字符串”
   else if (l_unlikely(!lua_isstring(L, -1)))
     luaL_error(L, "reader function must return a string");
-  // ջַƶλRESERVEDSLOTռջ
+  // 将栈顶的字符串移动到保留槽位（RESERVEDSLOT），避免占用栈顶
   lua_replace(L, RESERVEDSLOT);  /* save string in reserved slot */
-  // ӱλлȡַ䳤
+  // 从保留槽位中获取字符串及其长度
   return lua_tolstring(L, RESERVEDSLOT, size);
 }
 
 
-// ̬غͱLua
+// 动态加载和编译Lua代码块
 static int luaB_load (lua_State *L) {
   int status;
   size_t l;
-  // һַsַָΪNULL
+  // 如果第一个参数是字符串，则s指向该字符串；否则为NULL
   const char *s = lua_tolstring(L, 1, &l);
-  // ȡĵʾģʽĬΪ"bt"ͬʱ֧ıͶƸʽ
+  // 获取的第三个参数，表示加载模式（默认为"bt"，即同时支持文本和二进制格式）
   const char *mode = luaL_optstring(L, 3, "bt");
-  // ĸǷڣΪΪ0
+  /* a Lua string or reader cannot guarantee a fixed buffer */
+  luaL_argcheck(L, strchr(mode, 'B') == NULL, 3, "invalid mode");
+  // 检查第四个参数是否存在，如果存在则将其作为环境表；否则为0
   int env = (!lua_isnone(L, 4) ? 4 : 0);  /* 'env' index or 0 if no 'env' */
   if (s != NULL) {  /* loading a string? */
-    // sΪNULLڶΪʶƣûеĻĬΪs
+    // s不为NULL，第二个参数作为标识代码块的名称，如果没有的话，默认为s
     const char *chunkname = luaL_optstring(L, 2, s);
-    // ַ
+    // 加载字符串代码
     status = luaL_loadbufferx(L, s, l, chunkname, mode);
   }
   else {  /* loading from a reader function */
-    // sΪNULLڶΪʶƣûеĻĬΪ"=(load)"
+    // 如果s为NULL，第二个参数作为标识代码块的名称，如果没有的话，默认为"=(load)"
     const char *chunkname = luaL_optstring(L, 2, "=(load)");
-    // һǶȡ
+    // 第一个参数是读取函数
     luaL_checktype(L, 1, LUA_TFUNCTION);
-    // lua_settopջΪRESERVEDSLOTȷһλȡʹ
+    // lua_settop将栈顶设置为RESERVEDSLOT，确保有一个保留槽位供读取器使用
     lua_settop(L, RESERVEDSLOT);  /* create reserved slot */
     status = lua_load(L, generic_reader, NULL, chunkname, mode);
   }
-  // ڴصĽ
+  // 用于处理加载的结果
   return load_aux(L, status, env);
 }
 
@@ -581,12 +591,12 @@ static const luaL_Reg base_funcs[] = {
 };
 
 
-// Lua׼ĳʼעܲȫֱLuaűеĻ
+// Lua标准库的初始化函数，负责注册基础功能并设置全局变量，是Lua脚本运行的基础
 LUAMOD_API int luaopen_base (lua_State *L) {
   /* open lib into global table */
-  // ȫֱѹջ
+  // 全局表压入栈
   lua_pushglobaltable(L);
-  // base_funcsƺͺѹȫֱ
+  // 把base_funcs中名称和函数压入全局表中
   luaL_setfuncs(L, base_funcs, 0);
   /* set global _G */
   lua_pushvalue(L, -1);
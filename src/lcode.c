@@ -2235,4 +2235,5 @@ void luaK_finish (FuncState *fs) {
       default: break;
     }
   }
+  luaP_fuse(p->code, fs->pc);  /* peephole pass */
 }
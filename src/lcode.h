@@ -23,7 +23,7 @@
 /*
 ** grep "ORDER OPR" if you change these enums  (ORDER OP)
 */
-// Ԫ
+// 二元运算符
 typedef enum BinOpr {
   /* arithmetic operators */
   OPR_ADD, OPR_SUB, OPR_MUL, OPR_MOD, OPR_POW,
@@ -43,20 +43,20 @@ typedef enum BinOpr {
 
 
 /* true if operation is foldable (that is, it is arithmetic or bitwise) */
-// 鵱ǰǷ۵
-// ۵ǱŻһָּڱ׶ζԱʽеĳм㣬ʱм
+// 检查当前运算符是否可折叠
+// 常量折叠：是编译器优化的一种技术，指的是在编译阶段对表达式中的常量进行计算，而不是在运行时进行计算
 #define foldbinop(op)	((op) <= OPR_SHR)
 
 
 #define luaK_codeABC(fs,o,a,b,c)	luaK_codeABCk(fs,o,a,b,c,0)
 
 
-// һԪ
+// 一元操作符
 typedef enum UnOpr { OPR_MINUS, OPR_BNOT, OPR_NOT, OPR_LEN, OPR_NOUNOPR } UnOpr;
 
 
 /* get (pointer to) instruction of given 'expdesc' */
-// ȡָ
+// 获取指令
 #define getinstruction(fs,e)	((fs)->f->code[(e)->u.info])
 
 
@@ -18,7 +18,7 @@
 #include "lualib.h"
 
 
-// ȡЭ߳
+// 获取协程线程
 static lua_State *getco (lua_State *L) {
   lua_State *co = lua_tothread(L, 1);
   luaL_argexpected(L, co, 1, "thread");
@@ -30,58 +30,58 @@ static lua_State *getco (lua_State *L) {
 ** Resumes a coroutine. Returns the number of results for non-error
 ** cases or -1 for errors.
 */
-// ָ()һЭ
-// Lԭʼ̣߳coҪָ̣߳narg
+// 恢复(启动)一个协程
+// L原始线程，co要恢复的线程，narg传入参数
 static int auxresume (lua_State *L, lua_State *co, int narg) {
   int status, nres;
-  // ȷco߳̿nargջռ
+  // 确保co线程可以容纳narg个参数到栈空间
   if (l_unlikely(!lua_checkstack(co, narg))) {
     lua_pushliteral(L, "too many arguments to resume");
     return -1;  /* error flag */
   }
-  // ԭʼ߳LջϵnargƵĿЭcoջ
+  // 将原始线程L栈上的narg个参数，复制到目标协程co的栈上
   /*
   * L:
   * [
-  * ...(һci)
+  * ...(上一个ci)
   * L->ci->func(coroutine.resume),
   * NL(new lua_state)
-  * 1
+  * 参数1
   * ...
-  * narg
-  * L->top(λ)
+  * 参数narg
+  * L->top(空闲位置)
   * ]
   *
   * NL:
   * [
-  * ...(һci)
+  * ...(上一个ci)
   * NL->ci->func,
-  * Э̺,
-  * NL->top(λ)
+  * 协程函数,
+  * NL->top(空闲位置)
   * ]
   */
   lua_xmove(L, co, narg);
   /*
   * L:
   * [
-  * ...(һci)
+  * ...(上一个ci)
   * L->ci->func(coroutine.resume),
   * NL(new lua_state)
-  * L->top(λ)
+  * L->top(空闲位置)
   * ]
   *
   * NL:
   * [
-  * ...(һci)
+  * ...(上一个ci)
   * NL->ci->func,
-  * Э̺,
-  * 1
+  * 协程函数,
+  * 参数1
   * ...
-  * narg
-  * NL->top(λ)
+  * 参数narg
+  * NL->top(空闲位置)
   * ]
   */
-  // (ָ)ĿЭcoִ
+  // 启动(恢复)目标协程co的执行
   status = lua_resume(co, L, narg, &nres);
   if (l_likely(status == LUA_OK || status == LUA_YIELD)) {
     if (l_unlikely(!lua_checkstack(L, nres + 1))) {
@@ -89,56 +89,56 @@ static int auxresume (lua_State *L, lua_State *co, int narg) {
       lua_pushliteral(L, "too many results to resume");
       return -1;  /* error flag */
     }
-    // coջеķֵƶԭʼ߳
+    // 将co栈中的返回值移动到原始线程
     /*
     * L:
     * [
-    * ...(һci)
+    * ...(上一个ci)
     * L->ci->func(coroutine.resume),
     * NL(new lua_state)
-    * NLֵ1
+    * NL返回值1
     * ...
-    * NLֵnres
-    * L->top(λ)
+    * NL返回值nres
+    * L->top(空闲位置)
     * ]
     *
     * NL:
     * [
-    * ...(һci)
-    * NL->top(λ)
+    * ...(上一个ci)
+    * NL->top(空闲位置)
     * ]
     */
     lua_xmove(co, L, nres);  /* move yielded values */
     return nres;
   }
   else {
-    // ˵˴
+    // 说明发生了错误
     lua_xmove(co, L, 1);  /* move error message */
     return -1;  /* error flag */
   }
 }
 
 
-// Э̵(ָ)
+// 协程的启动(恢复)
 static int luaB_coresume (lua_State *L) {
-  // õЭ߳
+  // 得到协程线程
   lua_State *co = getco(L);
   int r;
-  // ģ߻ָЭ
+  // 核心：启动或者恢复协程
   r = auxresume(L, co, lua_gettop(L) - 1);
   if (l_unlikely(r < 0)) {
-    // ʧˣջѾдϢˣٴѹfalse
+    // 失败了，栈中已经有错误信息了，再次压入false
     lua_pushboolean(L, 0);
-    // falseŵϢǰ
+    // false放到错误信息前面
     // local bRet, val = coroutine.resume(co, 1)
     // OP_CALL,/* A B C R[A], ... ,R[A+C-2] := R[A](R[A+1], ... ,R[A+B-1]) */
     lua_insert(L, -2);
     return 2;  /* return false + error message */
   }
   else {
-    // ɹˣջѾrҪصֵ
+    // 成功了，栈中已经有r个要返回的值了
     lua_pushboolean(L, 1);
-    // ͬ
+    // 同理
     lua_insert(L, -(r + 1));
     return r + 1;  /* return true + 'resume' returns */
   }
@@ -168,52 +168,52 @@ static int luaB_auxwrap (lua_State *L) {
 }
 
 
-// һЭ
+// 创建一个协程
 /*
-* ʹøջ
+* 使用辅助栈底
 * L:
 * [
-* ...(һci)
+* ...(上一个ci)
 * L->ci->func(coroutine.create),
-* Э̺LClosure,
-* NL
-* L->top(λ)
+* 协程函数LClosure,
+* NL的
+* L->top(空闲位置)
 * ]
 *
 * NL:
 * [
 * NL->ci->func,
-* Э̺LClosure,
-* NL->top(λ)
+* 协程函数LClosure,
+* NL->top(空闲位置)
 * ]
 *
-* Lغ
+* L返回后
 * L:
 * [
-* ...(һci)
+* ...(上一个ci)
 * NL
-* L->top(λ)
+* L->top(空闲位置)
 * ]
 */
 static int luaB_cocreate (lua_State *L) {
   lua_State *NL;
-  // ȷǰջĵһԪһ
+  // 确保当前栈的第一个元素是一个函数
   luaL_checktype(L, 1, LUA_TFUNCTION);
-  // һµlua̲߳ѹջ
+  // 创建一个新的lua线程并压入栈
   NL = lua_newthread(L);
-  // ٴΰѺѹջ
+  // 再次把函数压入栈
   lua_pushvalue(L, 1);  /* move function to top */
-  // ٽջеĺƶµ߳
+  // 再将栈中的函数移动到新的线程
   lua_xmove(L, NL, 1);  /* move function from L to NL */
   return 1;
 }
 
 
-// һװfuncЭ̣Ȼ󷵻һøЭ̵ĺ
+// 创建一个包装func的协程，然后返回一个调用该协程的函数
 static int luaB_cowrap (lua_State *L) {
-  // ȴһЭ
+  // 先创建一个协程
   luaB_cocreate(L);
-  // ЭΪupvalueluaB_auxwrap
+  // 将协程作为upvalue传入luaB_auxwrap
   lua_pushcclosure(L, luaB_auxwrap, 1);
   return 1;
 }
@@ -225,14 +225,14 @@ static int luaB_yield (lua_State *L) {
 }
 
 
-// Э̵״̬
-// Эʱ״̬
+// 协程的状态
+// 协程正在运行时的状态
 #define COS_RUN		0
-// ЭѾûдʱ߷ʱ״̬
+// 协程已经结束并且没有错误时，或者发生错误时，会是这个状态
 #define COS_DEAD	1
-// Э̹ʱһyieldؼʱЭ״̬Ϊsuspended
+// 协程挂起时，当遇到一个yield关键字时，协程状态会变为suspended
 #define COS_YIELD	2
-// Э̴״̬ûйЭAлЭBAʹnormal״̬Brunning״̬
+// 协程处于正常状态，没有挂起，协程A切换到协程B，A就处于normal状态，B是running状态
 #define COS_NORM	3
 
 
@@ -240,16 +240,16 @@ static const char *const statname[] =
   {"running", "dead", "suspended", "normal"};
 
 
-// ״̬ӦЭ״̬Ĺϵ:״̬LUA_YIELD ӦЭ̵Ĺ״̬
-// ״̬LUA_OK ӦЭ̵,,״̬
+// 状态对应协程状态的关系:状态码LUA_YIELD 对应协程的挂起状态
+// 状态码LUA_OK 对应协程的正常,运行,死亡状态
 static int auxstatus (lua_State *L, lua_State *co) {
-  // ǵǰеЭ
+  // 如果是当前正在运行的协程
   if (L == co) return COS_RUN;
   else {
     switch (lua_status(co)) {
       // 
       case LUA_YIELD:
-        // ӦĹ
+        // 对应的挂起
         return COS_YIELD;
       case LUA_OK: {
         lua_Debug ar;
@@ -270,7 +270,7 @@ static int auxstatus (lua_State *L, lua_State *co) {
 }
 
 
-// ȡЭ״̬
+// 获取协程状态
 static int luaB_costatus (lua_State *L) {
   lua_State *co = getco(L);
   lua_pushstring(L, statname[auxstatus(L, co)]);
@@ -292,7 +292,7 @@ static int luaB_corunning (lua_State *L) {
 }
 
 
-// Э̹ر
+// 协程关闭
 static int luaB_close (lua_State *L) {
   lua_State *co = getco(L);
   int status = auxstatus(L, co);
@@ -315,7 +315,7 @@ static int luaB_close (lua_State *L) {
 }
 
 
-// ЭCoroutineĺ
+// 协程Coroutine导出的函数
 static const luaL_Reg co_funcs[] = {
   {"create", luaB_cocreate},
   {"resume", luaB_coresume},
@@ -25,16 +25,16 @@
 #endif
 
 
-// ټַ
-// 0x01 0000 0001 - ALPHABIT ĸַ
-// 0x02 0000 0010 - DIGITBIT ַ
-// 0x08 0000 1000 - SPACEBIT հַ
-// 0x10 0001 0000 - XDIGITBIT ʮַ
-// 0x04 0000 0100 - PRINTBIT ɴӡַ
-// 0x0c 0000 1100 - ɴӡ+հַ
-// 0x16 0001 0110 - ʮַ+ɴӡ+ַ
-// 0x15 0001 0101 - ַ+ɴӡ+ĸַ
-// NONA - Ѿascii
+// 快速检查字符的类型
+// 0x01 0000 0001 - ALPHABIT 字母字符
+// 0x02 0000 0010 - DIGITBIT 数字字符
+// 0x08 0000 1000 - SPACEBIT 空白字符
+// 0x10 0001 0000 - XDIGITBIT 十六进制数字字符
+// 0x04 0000 0100 - PRINTBIT 可打印字符
+// 0x0c 0000 1100 - 可打印+空白字符
+// 0x16 0001 0110 - 十六进制数字字符+可打印+数字字符
+// 0x15 0001 0101 - 数字字符+可打印+字母字符
+// NONA - 已经不是ascii
 LUAI_DDEF const lu_byte luai_ctype_[UCHAR_MAX + 2] = {
   0x00,  /* EOZ */
   0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,  0x00,	/* 0. */
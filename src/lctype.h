@@ -36,15 +36,15 @@
 #include "llimits.h"
 
 
-// ĸַ0x01
+// 字母字符，0x01
 #define ALPHABIT	0
-// ַ0x02
+// 数字字符，0x02
 #define DIGITBIT	1
-// ɴӡַ0x04
+// 可打印字符，0x04
 #define PRINTBIT	2
-// հַ0x08
+// 空白字符，0x08
 #define SPACEBIT	3
-// ʮַ0x10
+// 十六进制数字字符，0x10
 #define XDIGITBIT	4
 
 
@@ -54,23 +54,23 @@
 /*
 ** add 1 to char to allow index -1 (EOZ)
 */
-// +1Ӧasciiȷ±
+// +1对应到ascii正确下标
 #define testprop(c,p)	(luai_ctype_[(c)+1] & (p))
 
 /*
 ** 'lalpha' (Lua alphabetic) and 'lalnum' (Lua alphanumeric) both include '_'
 */
-// Ƿĸ
+// 是否是字母
 #define lislalpha(c)	testprop(c, MASK(ALPHABIT))
-// Ƿĸ
+// 是否是字母或者数字
 #define lislalnum(c)	testprop(c, (MASK(ALPHABIT) | MASK(DIGITBIT)))
-// Ƿ
+// 是否是数字
 #define lisdigit(c)	testprop(c, MASK(DIGITBIT))
-// Ƿǿհַ
+// 是否是空白字符
 #define lisspace(c)	testprop(c, MASK(SPACEBIT))
-// Ƿǿɴӡַ
+// 是否是可打印字符
 #define lisprint(c)	testprop(c, MASK(PRINTBIT))
-// Ƿʮַ
+// 是否是十六进制数字字符
 #define lisxdigit(c)	testprop(c, MASK(XDIGITBIT))
 
 
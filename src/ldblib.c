@@ -255,31 +255,31 @@ static int db_setlocal (lua_State *L) {
 /*
 ** get (if 'get' is true) or set an upvalue from a closure
 */
-// ڻȡñհclosureֵupvalueĸ
+// 用于获取或设置闭包（closure）上值（upvalue）的辅助函数
 static int auxupvalue (lua_State *L, int get) {
   const char *name;
   int n = (int)luaL_checkinteger(L, 2);  /* upvalue index */
   luaL_checktype(L, 1, LUA_TFUNCTION);  /* closure */
   name = get ? lua_getupvalue(L, 1, n) : lua_setupvalue(L, 1, n);
   if (name == NULL) return 0;
-  // ֵΪַ͵ջ
+  // 将上值的名称作为字符串推送到栈顶
   lua_pushstring(L, name);
-  // ǻȡgetΪtrueջ˳ʹֵλֵֵ֮ǰ
-  // òget Ϊ false˲ʵЧ
+  // 如果是获取操作（get为true），调整栈顺序，使得上值名称位于上值值之前
+  // 如果是设置操作（get 为 false），此操作无实际效果
   lua_insert(L, -(get+1));  /* no-op if get is false */
-  // ǻȡ2ʾջֵƺֵֵ
-  // ò1ʾջһֵƣ
+  // 如果是获取操作，返回2，表示栈中有两个结果（上值名称和上值值）
+  // 如果是设置操作，返回1，表示栈中有一个结果（上值名称）
   return get + 1;
 }
 
 
-// ȡֵָ
+// 获取指定函数的上值
 static int db_getupvalue (lua_State *L) {
   return auxupvalue(L, 1);
 }
 
 
-// ֵָ
+// 用于设置指定函数的上值
 static int db_setupvalue (lua_State *L) {
   luaL_checkany(L, 3);
   return auxupvalue(L, 0);
@@ -303,7 +303,7 @@ static void *checkupval (lua_State *L, int argf, int argnup, int *pnup) {
 }
 
 
-// رհֵָΨһʶ
+// 返回闭包中指定上值的唯一标识符
 static int db_upvalueid (lua_State *L) {
   void *id = checkupval(L, 1, 2, NULL);
   if (id != NULL)
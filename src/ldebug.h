@@ -15,7 +15,7 @@
 
 
 /* Active Lua function (given call info) */
-// ȡluaհ
+// 获取lua闭包
 #define ci_func(ci)		(clLvalue(s2v((ci)->func.p)))
 
 
@@ -1099,9 +1099,12 @@ static void f_parser (lua_State *L, void *ud) {
   struct SParser *p = cast(struct SParser *, ud);
   int c = zgetc(p->z);  /* read first character */
   if (c == LUA_SIGNATURE[0]) {
+    /* mode 'B': binary chunk in a fixed buffer (see 'luaU_undump') */
+    int fixed = (p->mode != NULL && strchr(p->mode, 'B') != NULL);
     // 读取预编译好的lua chunks
-    checkmode(L, p->mode, "binary");
-    cl = luaU_undump(L, p->z, p->name);
+    if (!fixed)
+      checkmode(L, p->mode, "binary");
+    cl = luaU_undump(L, p->z, p->name, fixed);
   }
   else {
     // 解析
@@ -23,24 +23,24 @@
 ** 'condmovestack' is used in heavy tests to force a stack reallocation
 ** at every check.
 */
-// 鵱ǰLuaջʣռǷ㹻nԪء㣬չջռ
-// ջչǰִһЩͨprepos
-// ɣcondmovestackǿ·䣬ҲҪǷ
-// Ĭ²
+// 检查当前Lua栈的剩余空间是否足够容纳n个元素。如果不足，则扩展栈空间
+// 允许在栈扩展前后执行一些操作（通过pre和pos参数）。
+// 如果满足容纳，调用condmovestack强制重新分配，但是这个也要看是否开启了
+// 默认情况下不开启
 #define luaD_checkstackaux(L,n,pre,pos)  \
 	if (l_unlikely(L->stack_last.p - L->top.p <= (n))) \
 	  { pre; luaD_growstack(L, n, 1); pos; } \
         else { condmovestack(L,pre,pos); }
 
-// ûpreproȷջռ㹻nԪ
+// 没有pre和pro的上面操作，确保栈空间足够容纳n个元素
 /* In general, 'pre'/'pos' are empty (nothing to save) */
 #define luaD_checkstack(L,n)	luaD_checkstackaux(L,n,(void)0,(void)0)
 
 
 
-// pջײƫ
+// 计算出p和栈底部的偏移
 #define savestack(L,pt)		(cast_charp(pt) - cast_charp(L->stack.p))
-// ҵp
+// 找到上面的p
 #define restorestack(L,n)	cast(StkId, cast_charp(L->stack.p) + (n))
 
 
@@ -52,8 +52,8 @@
 
 
 /* macro to check stack size and GC, preserving 'p' */
-// ȷǰջ㹻ĿռnԪ
-// ջչǰͨsavestackGCrestorestackͻָָp
+// 确保当前栈有足够的空间来容纳n个新元素
+// 在栈扩展前后，通过savestack和GC，restorestack保存和恢复指针p
 #define checkstackGCp(L,n,p)  \
   luaD_checkstackaux(L, n, \
     ptrdiff_t t__ = savestack(L, p);  /* save 'p' */ \
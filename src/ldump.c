@@ -15,8 +15,12 @@
 
 #include "lua.h"
 
+#include "ldo.h"
+#include "lmem.h"
 #include "lobject.h"
+#include "lopcodes.h"
 #include "lstate.h"
+#include "lstring.h"
 #include "lundump.h"
 
 
@@ -26,6 +30,13 @@ typedef struct {
   void *data;
   int strip;
   int status;
+  const Proto *f;  /* function being dumped */
+  /* strings of the chunk, numbered from 1 in order of first use */
+  TString **strs;
+  int nstrs;
+  int sizestrs;
+  int *sidx;  /* hash of indices in 'strs' (0 is empty) */
+  int sizesidx;  /* size of 'sidx' (a power of 2) */
 } DumpState;
 
 
@@ -89,21 +100,142 @@ static void dumpInteger (DumpState *D, lua_Integer x) {
 }
 
 
-static void dumpString (DumpState *D, const TString *s) {
+/* dump 'x - base' (with wrap-around) in zigzag encoding */
+static void dumpDelta (DumpState *D, int x, int base) {
+  unsigned int u = cast_uint(x) - cast_uint(base);
+  dumpSize(D, (u << 1) ^ (0u - (u >> 31)));
+}
+
+
+/*
+** {======================================================
+** String table
+** =======================================================
+*/
+
+/*
+** All strings of a chunk (constants, sources and debug names) are
+** dumped once, in a table after the header; functions refer to them by
+** their indices in that table. Equal long strings are also merged.
+*/
+
+static unsigned int strHash (TString *ts) {
+  return (ts->tt == LUA_VSHRSTR) ? ts->hash : luaS_hashlongstr(ts);
+}
+
+
+static int eqStr (TString *a, TString *b) {
+  return (a == b) ||
+         (a->tt == LUA_VLNGSTR && b->tt == LUA_VLNGSTR && luaS_eqlngstr(a, b));
+}
+
+
+/* slot in 'sidx' for string 'ts' (either empty or with its index) */
+static int *findSlot (DumpState *D, TString *ts) {
+  unsigned int mask = cast_uint(D->sizesidx - 1);
+  unsigned int h = strHash(ts) & mask;
+  while (D->sidx[h] != 0 && !eqStr(D->strs[D->sidx[h] - 1], ts))
+    h = (h + 1) & mask;  /* linear probing */
+  return &D->sidx[h];
+}
+
+
+static void growIndices (DumpState *D) {
+  int i;
+  int osize = D->sizesidx;
+  int *old = D->sidx;
+  int nsize = (osize == 0) ? 64 : osize * 2;
+  D->sidx = luaM_newvector(D->L, nsize, int);
+  D->sizesidx = nsize;
+  for (i = 0; i < nsize; i++)
+    D->sidx[i] = 0;
+  for (i = 0; i < D->nstrs; i++)  /* reinsert old strings */
+    *findSlot(D, D->strs[i]) = i + 1;
+  luaM_freearray(D->L, old, osize);
+}
+
+
+static void saveString (DumpState *D, TString *ts) {
+  int *slot;
+  if (ts == NULL)
+    return;
+  if (2 * (D->nstrs + 1) > D->sizesidx)  /* keep load factor below 1/2 */
+    growIndices(D);
+  slot = findSlot(D, ts);
+  if (*slot == 0) {  /* new string? */
+    luaM_growvector(D->L, D->strs, D->nstrs, D->sizestrs, TString *,
+                    MAX_INT, "strings");
+    D->strs[D->nstrs++] = ts;
+    *slot = D->nstrs;
+  }
+}
+
+
+/* collect strings in the order that 'dumpFunction' uses them */
+static void collectStrings (DumpState *D, const Proto *f, TString *psource) {
+  int i;
+  if (!D->strip && f->source != psource)
+    saveString(D, f->source);
+  for (i = 0; i < f->sizek; i++) {
+    if (ttisstring(&f->k[i]))
+      saveString(D, tsvalue(&f->k[i]));
+  }
+  for (i = 0; i < f->sizep; i++) {
+    if (f->p[i]->flag & PF_LAZY)  /* not loaded yet? */
+      luaU_loadlazy(D->L, cast(Proto *, f), i);
+    collectStrings(D, f->p[i], f->source);
+  }
+  if (!D->strip) {
+    for (i = 0; i < f->sizelocvars; i++)
+      saveString(D, f->locvars[i].varname);
+    for (i = 0; i < f->sizeupvalues; i++)
+      saveString(D, f->upvalues[i].name);
+  }
+}
+
+
+/*
+** Long strings are dumped with their ending '\0', so that they can be
+** used in place (see 'loadStrings').
+*/
+static void dumpStrings (DumpState *D) {
+  int i;
+  dumpInt(D, D->nstrs);
+  for (i = 0; i < D->nstrs; i++) {
+    TString *ts = D->strs[i];
+    size_t size = tsslen(ts);
+    dumpSize(D, size);
+    dumpVector(D, getstr(ts), size + (ts->tt == LUA_VLNGSTR));
+  }
+}
+
+
+/* a string is its index in the table, or 0 for NULL */
+static void dumpString (DumpState *D, TString *s) {
   if (s == NULL)
     dumpSize(D, 0);
   else {
-    size_t size = tsslen(s);
-    const char *str = getstr(s);
-    dumpSize(D, size + 1);
-    dumpVector(D, str, size);
+    int idx = *findSlot(D, s);
+    lua_assert(idx != 0);
+    dumpInt(D, idx);
   }
 }
 
+/* }====================================================== */
 
+
+/*
+** Dump only basic opcodes, so that binary chunks do not depend on the
+** peephole pass ('luaP_fuse'), which is redone when loading them.
+*/
 static void dumpCode (DumpState *D, const Proto *f) {
+  int i;
   dumpInt(D, f->sizecode);
-  dumpVector(D, f->code, f->sizecode);
+  for (i = 0; i < f->sizecode; i++) {
+    Instruction inst = f->code[i];
+    SET_OPCODE(inst, GET_BASEOPCODE(inst));
+    dumpVar(D, inst);
+  }
 }
 
 
@@ -139,7 +271,7 @@ static void dumpProtos (DumpState *D, const Proto *f) {
   int i;
   int n = f->sizep;
   dumpInt(D, n);
-  for (i = 0; i < n; i++)
+  for (i = 0; i < n; i++)  /* ('collectStrings' loaded them all) */
     dumpFunction(D, f->p[i], f->source);
 }
 
@@ -162,16 +294,19 @@ static void dumpDebug (DumpState *D, const Proto *f) {
   dumpVector(D, f->lineinfo, n);
   n = (D->strip) ? 0 : f->sizeabslineinfo;
   dumpInt(D, n);
-  for (i = 0; i < n; i++) {
-    dumpInt(D, f->abslineinfo[i].pc);
-    dumpInt(D, f->abslineinfo[i].line);
+  for (i = 0; i < n; i++) {  /* differences from previous entries */
+    int pc = (i == 0) ? 0 : f->abslineinfo[i - 1].pc;
+    int line = (i == 0) ? f->linedefined : f->abslineinfo[i - 1].line;
+    dumpDelta(D, f->abslineinfo[i].pc, pc);
+    dumpDelta(D, f->abslineinfo[i].line, line);
   }
   n = (D->strip) ? 0 : f->sizelocvars;
   dumpInt(D, n);
-  for (i = 0; i < n; i++) {
+  for (i = 0; i < n; i++) {  /* 'startpc' relative to previous one */
+    int pc = (i == 0) ? 0 : f->locvars[i - 1].startpc;
     dumpString(D, f->locvars[i].varname);
-    dumpInt(D, f->locvars[i].startpc);
-    dumpInt(D, f->locvars[i].endpc);
+    dumpDelta(D, f->locvars[i].startpc, pc);
+    dumpDelta(D, f->locvars[i].endpc, f->locvars[i].startpc);
   }
   n = (D->strip) ? 0 : f->sizeupvalues;
   dumpInt(D, n);
@@ -201,7 +336,7 @@ static void dumpFunction (DumpState *D, const Proto *f, TString *psource) {
 static void dumpHeader (DumpState *D) {
   dumpLiteral(D, LUA_SIGNATURE);
   dumpByte(D, LUAC_VERSION);
-  dumpByte(D, LUAC_FORMAT);
+  dumpByte(D, LUAC_FORMATSTR);
   dumpLiteral(D, LUAC_DATA);
   dumpByte(D, sizeof(Instruction));
   dumpByte(D, sizeof(lua_Integer));
@@ -211,20 +346,37 @@ static void dumpHeader (DumpState *D) {
 }
 
 
+static void f_dump (lua_State *L, void *ud) {
+  DumpState *D = cast(DumpState *, ud);
+  UNUSED(L);
+  collectStrings(D, D->f, NULL);
+  dumpHeader(D);
+  dumpStrings(D);
+  dumpByte(D, D->f->sizeupvalues);
+  dumpFunction(D, D->f, NULL);
+}
+
+
 /*
 ** dump Lua function as precompiled chunk
 */
 int luaU_dump(lua_State *L, const Proto *f, lua_Writer w, void *data,
               int strip) {
   DumpState D;
+  int status;
   D.L = L;
   D.writer = w;
   D.data = data;
   D.strip = strip;
   D.status = 0;
-  dumpHeader(&D);
-  dumpByte(&D, f->sizeupvalues);
-  dumpFunction(&D, f, NULL);
+  D.f = f;
+  D.strs = NULL; D.nstrs = D.sizestrs = 0;
+  D.sidx = NULL; D.sizesidx = 0;
+  /* run protected, so that the string table is freed after errors */
+  status = luaD_rawrunprotected(L, f_dump, &D);
+  luaM_freearray(L, D.strs, D.sizestrs);
+  luaM_freearray(L, D.sidx, D.sizesidx);
+  if (l_unlikely(status != LUA_OK))
+    luaD_throw(L, status);  /* propagate error */
   return D.status;
 }
-
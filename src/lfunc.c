@@ -261,6 +261,7 @@ Proto *luaF_newproto (lua_State *L) {
   f->p = NULL;
   f->sizep = 0;
   f->code = NULL;
+  f->icache = NULL;
   f->sizecode = 0;
   f->lineinfo = NULL;
   f->sizelineinfo = 0;
@@ -271,6 +272,10 @@ Proto *luaF_newproto (lua_State *L) {
   f->numparams = 0;
   f->is_vararg = 0;
   f->maxstacksize = 0;
+  f->flag = 0;
+  f->lazy = NULL;
+  f->sizelazy = 0;
+  f->image = NULL;
   f->locvars = NULL;
   f->sizelocvars = 0;
   f->linedefined = 0;
@@ -280,11 +285,27 @@ Proto *luaF_newproto (lua_State *L) {
 }
 
 
+/*
+** Create the inline caches of a prototype, after its code is complete.
+** Each instruction gets an entry, although only the field-access
+** opcodes use theirs.
+*/
+void luaF_newicache (lua_State *L, Proto *f) {
+  int i;
+  f->icache = luaM_newvector(L, f->sizecode, unsigned int);
+  for (i = 0; i < f->sizecode; i++)
+    f->icache[i] = 0;
+}
+
+
 void luaF_freeproto (lua_State *L, Proto *f) {
   luaM_freearray(L, f->code, f->sizecode);
+  if (f->icache != NULL)  /* caches may be missing after an error */
+    luaM_freearray(L, f->icache, f->sizecode);
   luaM_freearray(L, f->p, f->sizep);
   luaM_freearray(L, f->k, f->sizek);
-  luaM_freearray(L, f->lineinfo, f->sizelineinfo);
+  if (!(f->flag & PF_FIXED))  /* 'lineinfo' owned by the prototype? */
+    luaM_freearray(L, f->lineinfo, f->sizelineinfo);
   luaM_freearray(L, f->abslineinfo, f->sizeabslineinfo);
   luaM_freearray(L, f->locvars, f->sizelocvars);
   luaM_freearray(L, f->upvalues, f->sizeupvalues);
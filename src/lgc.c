@@ -255,6 +255,144 @@ void luaC_barrierback_ (lua_State *L, GCObject *o) {
 }
 
 
+/*
+** {======================================================
+** Card tables
+** Large tables ('LUAI_MINCARDSLOTS') have a card table, kept in
+** 'g->cards' so that other tables pay nothing for it. In generational
+** mode, a store of a young object into an old table dirties the card
+** of its slot; a young collection then traverses only the dirty cards
+** of a touched table, instead of the whole table.
+** =======================================================
+*/
+
+/* main position of table 't' in the card map */
+#define cardpos(m,t)	lmod(point2uint(t) >> 4, (m)->size)
+
+
+static CardEntry *findcards (global_State *g, const Table *t) {
+  cardmap *m = &g->cards;
+  unsigned int i = cardpos(m, t);
+  lua_assert(hascards(t));
+  while (m->e[i].t != t) {
+    lua_assert(m->e[i].t != NULL);
+    i = lmod(i + 1, m->size);
+  }
+  return &m->e[i];
+}
+
+
+static void insertcards (cardmap *m, Table *t, lu_byte *cards) {
+  unsigned int i = cardpos(m, t);
+  while (m->e[i].t != NULL)
+    i = lmod(i + 1, m->size);
+  m->e[i].t = t;
+  m->e[i].cards = cards;
+  m->nuse++;
+}
+
+
+static void growcardmap (lua_State *L, cardmap *m) {
+  int osize = m->size;
+  CardEntry *oe = m->e;
+  int i;
+  int nsize = (osize == 0) ? 4 : 2 * osize;
+  m->e = luaM_newvector(L, nsize, CardEntry);
+  m->size = nsize;
+  m->nuse = 0;
+  for (i = 0; i < nsize; i++)
+    m->e[i].t = NULL;
+  for (i = 0; i < osize; i++) {
+    if (oe[i].t != NULL)
+      insertcards(m, oe[i].t, oe[i].cards);
+  }
+  luaM_freearray(L, oe, osize);
+}
+
+
+/*
+** Create a (clean) card table with 'n' entries for table 't'.
+*/
+lu_byte *luaC_newcards (lua_State *L, Table *t, unsigned int n) {
+  cardmap *m = &G(L)->cards;
+  lu_byte *cards;
+  lua_assert(!hascards(t));
+  if (4 * (m->nuse + 1) > 3 * m->size)  /* map too crowded? */
+    growcardmap(L, m);
+  cards = luaM_newvector(L, n, lu_byte);
+  memset(cards, 0, n);
+  insertcards(m, t, cards);
+  t->flags |= BITCARDS;
+  return cards;
+}
+
+
+/*
+** Free the card table (with 'n' entries) of table 't'. Following
+** entries in the same cluster move back to fill the hole, so that
+** searches never need tombstones.
+*/
+void luaC_freecards (lua_State *L, Table *t, unsigned int n) {
+  cardmap *m = &G(L)->cards;
+  CardEntry *e = findcards(G(L), t);
+  unsigned int i = cast_uint(e - m->e);
+  unsigned int j = i;
+  luaM_freearray(L, e->cards, n);
+  for (;;) {
+    unsigned int k;
+    j = lmod(j + 1, m->size);
+    if (m->e[j].t == NULL)
+      break;
+    k = cardpos(m, m->e[j].t);
+    /* can entry 'j' move back to 'i'? (is 'k' cyclically outside (i,j]?) */
+    if ((i <= j) ? (k <= i || k > j) : (k <= i && k > j)) {
+      m->e[i] = m->e[j];
+      i = j;
+    }
+  }
+  m->e[i].t = NULL;
+  m->nuse--;
+  t->flags &= cast_byte(~BITCARDS);
+}
+
+
+/*
+** Remember that 'slot' of table 't', which has a card table, may now
+** refer to a young object. Young tables do not need that, as a young
+** collection traverses them entirely. A card is enough only if all
+** other young objects in the table are also in dirty cards, that is,
+** if the table was really old or touched; an OLD0/OLD1 table may
+** still refer to survival objects anywhere, so it is traversed
+** entirely (while it may hold any of them).
+*/
+void luaC_markcard (global_State *g, Table *t, const TValue *slot) {
+  if (isold(t)) {  /* generational mode? */
+    lu_byte *cards = findcards(g, t)->cards;
+    int age = getage(t);
+    if (age == G_OLD || age == G_TOUCHED1 || age == G_TOUCHED2)
+      cards[luaH_cardof(t, slot)] = CARDDIRTY;
+    else
+      cards[0] = CARDDIRTY;  /* whole table */
+  }
+}
+
+
+/*
+** Barrier for the store of a white value into 'slot' of table 't'.
+** Besides the back barrier, it keeps the card table up to date, also
+** when 't' is gray (a touched table in 'grayagain' gets no barrier but
+** will be traversed only through its cards).
+*/
+void luaC_barriertable_ (lua_State *L, Table *t, const TValue *slot) {
+  if (hascards(t))
+    luaC_markcard(G(L), t, slot);
+  if (isblack(t))
+    luaC_barrierback_(L, obj2gco(t));
+}
+
+/* }====================================================== */
+
+
 // 把需要长驻于内存的中GCObject对象从allgc链表中移出，
 // 并移入到同样声明在global_State中的fixedgc链表中进行特殊管理，
 // 这样在清除阶段就不会被遍历到了，就不会有一些多余的清除判断了
@@ -315,12 +453,18 @@ GCObject *luaC_newobj (lua_State *L, int tt, size_t sz) {
 // 染色函数
 static void reallymarkobject (global_State *g, GCObject *o) {
   switch (o->tt) {
-    case LUA_VSHRSTR:
-    case LUA_VLNGSTR: {
-      // 长短字符串直接染黑
+    case LUA_VSHRSTR: {
+      // 短字符串直接染黑
       set2black(o);  /* nothing to visit */
       break;
     }
+    case LUA_VLNGSTR: {
+      TString *ts = gco2ts(o);
+      set2black(o);  /* nothing to visit... */
+      if (isextstr(ts))  /* ...except the owner of a slice */
+        markobjectN(g, extstr(ts)->owner);
+      break;
+    }
     case LUA_VUPVAL: {
       // 上值
       UpVal *uv = gco2upv(o);
@@ -443,6 +587,7 @@ static void cleargraylists (global_State *g) {
 static void restartcollection (global_State *g) {
   // 清空灰色链表和弱表相关
   cleargraylists(g);
+  g->gcprecleaned = g->gcephmarked = 0;
   // 标记主状态机为灰色
   markobject(g, g->mainthread);
   // 标记全局注册表为灰色
@@ -578,9 +723,11 @@ static int traverseephemeron (global_State *g, Table *h, int inv) {
     }
   }
   /* link table into proper list */
-  if (g->gcstate == GCSpropagate)
+  if (g->gcstate == GCSpropagate) {
     // 只要是扫描阶段，都直接放入grayagain链表中，留到atomic阶段再处理
     linkgclist(h, g->grayagain);  /* must retraverse it in atomic phase */
+    g->gcephmarked |= marked;  /* precleaning is still converging */
+  }
   else if (hasww)  /* table has white->white entries? */
     // 肯定是到了原子阶段，如果发现 key 是 gc 对象，并且是白色，值也是白色，加入到 g->ephemeron 链表
     linkgclist(h, g->ephemeron);  /* have to propagate again */
@@ -593,11 +740,71 @@ static int traverseephemeron (global_State *g, Table *h, int inv) {
 }
 
 
+/*
+** Traverse the slots of the dirty cards of table 'h', aging the cards.
+*/
+static void traversecards (global_State *g, Table *h, lu_byte *cards) {
+  unsigned int asize = luaH_realasize(h);
+  unsigned int size = asize + allocsizenode(h);
+  unsigned int c, ncards = numcards(size);
+  for (c = 1; c < ncards; c++) {
+    if (cards[c] != 0) {  /* dirty card? */
+      unsigned int i = (c - 1) << CARDBITS;
+      unsigned int lim = (size - i < CARDSIZE) ? size : i + CARDSIZE;
+      cards[c]--;
+      for (; i < lim && i < asize; i++)  /* slots in the array part */
+        markvalue(g, &h->array[i]);
+      for (; i < lim; i++) {  /* slots in the hash part */
+        Node *n = gnode(h, i - asize);
+        if (isempty(gval(n)))
+          clearkey(n);
+        else {
+          markkey(g, n);
+          markvalue(g, gval(n));
+        }
+      }
+    }
+  }
+}
+
+
+/*
+** Check whether a table with cards can be traversed only through its
+** dirty cards: it must be a touched table (so, in a young collection)
+** whose young objects are all in those cards. Otherwise, the table will
+** be traversed entirely; a touched table then ages all its cards, and
+** any other table has them cleared, as after a full traversal only
+** a later store can put a young object in it.
+*/
+static int onlycards (Table *h, lu_byte *cards) {
+  unsigned int i, n = numcards(luaH_realasize(h) + allocsizenode(h));
+  if (getage(h) != G_TOUCHED1 && getage(h) != G_TOUCHED2) {
+    memset(cards, 0, n);
+    return 0;
+  }
+  else if (cards[0] == 0)
+    return 1;
+  for (i = 0; i < n; i++) {
+    if (cards[i] != 0)
+      cards[i]--;
+  }
+  return 0;
+}
+
+
 // 遍历table，标记所有可达的结点
 static void traversestrongtable (global_State *g, Table *h) {
   Node *n, *limit = gnodelast(h);
   unsigned int i;
   unsigned int asize = luaH_realasize(h);
+  if (hascards(h)) {  /* large table? */
+    lu_byte *cards = findcards(g, h)->cards;
+    if (onlycards(h, cards)) {
+      traversecards(g, h, cards);
+      genlink(g, obj2gco(h));
+      return;
+    }
+  }
   for (i = 0; i < asize; i++)  /* traverse array part */
     markvalue(g, &h->array[i]);
   for (n = gnode(h, 0); n < limit; n++) {  /* traverse hash part */
@@ -683,6 +890,7 @@ static int traverseudata (global_State *g, Udata *u) {
 static int traverseproto (global_State *g, Proto *f) {
   int i;
   markobjectN(g, f->source);
+  markobjectN(g, f->image);
   for (i = 0; i < f->sizek; i++)  /* mark literals */
     markvalue(g, &f->k[i]);
   for (i = 0; i < f->sizeupvalues; i++)  /* mark upvalue names */
@@ -928,7 +1136,14 @@ static void freeobj (lua_State *L, GCObject *o) {
     }
     case LUA_VLNGSTR: {
       TString *ts = gco2ts(o);
-      luaM_freemem(L, ts, sizelstring(ts->u.lnglen));
+      if (isextstr(ts)) {  /* external string? */
+        ExtString *e = extstr(ts);
+        if (e->falloc != NULL)  /* give contents back to the host */
+          (*e->falloc)(e->ud, e->s, ts->u.lnglen + 1, 0);
+        luaM_freemem(L, ts, sizeextstr);
+      }
+      else
+        luaM_freemem(L, ts, sizelstring(ts->u.lnglen));
       break;
     }
     default: lua_assert(0);
@@ -1001,7 +1216,8 @@ static GCObject **sweeptolive (lua_State *L, GCObject **p) {
 // 对字符串缓存进行检测回收
 static void checkSizes (lua_State *L, global_State *g) {
   if (!g->gcemergency) {
-    if (g->strt.nuse < g->strt.size / 4) {  /* string table too big? */
+    if (g->strt.nuse < g->strt.size / 4 &&  /* string table too big? */
+        g->strt.ohash == NULL) {  /* and not being resized? */
       l_mem olddebt = g->GCdebt;
       luaS_resize(L, g->strt.size / 2);
       g->GCestimate += g->GCdebt - olddebt;  /* correct estimate */
@@ -1743,6 +1959,29 @@ static void genstep (lua_State *L, global_State *g) {
   lua_assert(isdecGCmodegen(g));
 }
 
+
+/*
+** Does a minor collection right away, so that a program can free the
+** objects created by a unit of work (e.g., a request) when that work
+** ends: objects that escaped into old objects were caught by the
+** barriers and survive; everything else created since the previous
+** collection is freed. Only the generational mode has minor
+** collections, and not while it is recovering from a bad collection
+** (when it runs in incremental mode). Returns whether it collected.
+*/
+int luaC_younggc (lua_State *L) {
+  global_State *g = G(L);
+  if (g->gckind == KGC_GEN && g->lastatomic == 0) {
+    lu_mem majorbase = g->GCestimate;
+    youngcollection(L, g);
+    setminordebt(g);
+    g->GCestimate = majorbase;  /* preserve base value */
+    return 1;
+  }
+  else
+    return 0;
+}
+
 /* }====================================================== */
 
 
@@ -1803,6 +2042,45 @@ void luaC_freeallobjects (lua_State *L) {
 }
 
 
+/*
+** Precleaning: when the propagate phase runs out of gray objects, move
+** 'grayagain' (objects hit by back barriers, threads, weak tables) to
+** 'gray', so that most of the work the atomic phase would do on that
+** list is done incrementally. Objects go back to 'grayagain' as usual
+** (threads and weak tables always do), so the atomic phase still
+** revisits whatever is needed, but tables that were touched once early
+** in the cycle and not since are black again by then.
+** Each round also traverses the ephemeron tables, marking the values
+** of keys marked since the previous round; so, rounds are repeated
+** while they mark new values, which converges the ephemerons step by
+** step instead of in 'convergeephemerons'. Marking only grows during
+** the propagate phase, so these marks stay valid. What bounds the
+** rounds is their work: a cycle may spend at most 'g->gcpreclean' times
+** the heap size (in work units) in precleaning, so that a mutator that
+** keeps marking new values cannot hold the collector in this phase.
+** Whatever is left is done by the atomic phase, as before.
+** Only the incremental mode runs the propagate phase step by step.
+*/
+static int precleangrayagain (global_State *g) {
+  lua_assert(g->gckind == KGC_INC && g->gray == NULL);
+  if (g->grayagain == NULL || g->gcpreclean == 0)
+    return 0;  /* nothing to preclean */
+  if (!g->gcprecleaned) {  /* first round? */
+    l_mem heap = gettotalbytes(g) / WORK2MEM;
+    g->gcprecleanwork = (heap < MAX_LMEM / g->gcpreclean)  /* overflow? */
+                      ? heap * g->gcpreclean
+                      : MAX_LMEM;  /* overflow; truncate to maximum */
+    g->gcprecleaned = 1;
+  }
+  else if (!g->gcephmarked || g->gcprecleanwork <= 0)
+    return 0;  /* converged or out of budget */
+  g->gray = g->grayagain;
+  g->grayagain = NULL;
+  g->gcephmarked = 0;
+  return 1;
+}
+
+
 // 原子阶段，不可以分步执行
 static lu_mem atomic (lua_State *L) {
   global_State *g = G(L);
@@ -1915,12 +2193,21 @@ static lu_mem singlestep (lua_State *L) {
     case GCSpropagate: {
       // 扫描，可以分步
       if (g->gray == NULL) {  /* no more gray objects? */
-        // 扫描阶段结束
-        g->gcstate = GCSenteratomic;  /* finish propagate phase */
-        work = 0;
+        if (precleangrayagain(g)) {
+          // 预清理：grayagain链表先在扫描阶段分步遍历，减少原子阶段停顿
+          work = 0;
+        }
+        else {
+          // 扫描阶段结束
+          g->gcstate = GCSenteratomic;  /* finish propagate phase */
+          work = 0;
+        }
       }
-      else
+      else {
         work = propagatemark(g);  /* traverse one gray object */
+        if (g->gcprecleaned)  /* precleaning? */
+          g->gcprecleanwork -= work;
+      }
       break;
     }
     case GCSenteratomic: {
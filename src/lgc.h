@@ -151,6 +151,14 @@
 	check_exp(getage(o) == (f), (o)->marked ^= ((f)^(t)))
 
 
+/*
+** Value of a dirty card of a table (see 'luaC_markcard'). Like the ages
+** G_TOUCHED1/G_TOUCHED2, it counts the young collections that still
+** have to traverse the slots of the card.
+*/
+#define CARDDIRTY	2
+
+
 /* Default Values for GC parameters */
 #define LUAI_GENMAJORMUL         100
 #define LUAI_GENMINORMUL         20
@@ -173,6 +181,12 @@
 // 默认GC步长
 #define LUAI_GCSTEPSIZE 13      /* 8 KB */
 
+/* maximum precleaning work per cycle, in heap sizes (see 'lgc.c') */
+// 默认预清理工作量上限（堆大小的倍数）
+#if !defined(LUAI_GCPRECLEAN)
+#define LUAI_GCPRECLEAN	256
+#endif
+
 
 /*
 ** Check whether the declared GC mode is generational. While in
@@ -221,16 +235,29 @@
 #define luaC_barrierback(L,p,v) (  \
 	iscollectable(v) ? luaC_objbarrierback(L, p, gcvalue(v)) : cast_void(0))
 
+/* back barrier for the store of 'v' into 'slot' of table 't' */
+#define luaC_barriertable(L,t,slot,v) (  \
+	(iscollectable(v) && iswhite(gcvalue(v)) && \
+	 (isblack(t) || hascards(t))) ? \
+	luaC_barriertable_(L,t,slot) : cast_void(0))
+
 LUAI_FUNC void luaC_fix (lua_State *L, GCObject *o);
 LUAI_FUNC void luaC_freeallobjects (lua_State *L);
 LUAI_FUNC void luaC_step (lua_State *L);
 LUAI_FUNC void luaC_runtilstate (lua_State *L, int statesmask);
 LUAI_FUNC void luaC_fullgc (lua_State *L, int isemergency);
+LUAI_FUNC int luaC_younggc (lua_State *L);
 LUAI_FUNC GCObject *luaC_newobj (lua_State *L, int tt, size_t sz);
 LUAI_FUNC GCObject *luaC_newobjdt (lua_State *L, int tt, size_t sz,
                                                  size_t offset);
 LUAI_FUNC void luaC_barrier_ (lua_State *L, GCObject *o, GCObject *v);
 LUAI_FUNC void luaC_barrierback_ (lua_State *L, GCObject *o);
+LUAI_FUNC void luaC_barriertable_ (lua_State *L, Table *t,
+                                                 const TValue *slot);
+LUAI_FUNC void luaC_markcard (global_State *g, Table *t,
+                                              const TValue *slot);
+LUAI_FUNC lu_byte *luaC_newcards (lua_State *L, Table *t, unsigned int n);
+LUAI_FUNC void luaC_freecards (lua_State *L, Table *t, unsigned int n);
 LUAI_FUNC void luaC_checkfinalizer (lua_State *L, GCObject *o, Table *mt);
 LUAI_FUNC void luaC_changemode (lua_State *L, int newmode);
 
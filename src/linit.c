@@ -64,7 +64,7 @@ static const luaL_Reg loadedlibs[] = {
 };
 
 
-// زעLuaб׼⵽Luaȫֱ
+// 加载并注册Lua的所有标准库到Lua的全局表中
 LUALIB_API void luaL_openlibs (lua_State *L) {
   const luaL_Reg *lib;
   /* "require" functions from 'loadedlibs' and set results to global table */
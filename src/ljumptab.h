@@ -107,6 +107,17 @@ static const void *const disptab[NUM_OPCODES] = {
 &&L_OP_CLOSURE,
 &&L_OP_VARARG,
 &&L_OP_VARARGPREP,
-&&L_OP_EXTRAARG
+&&L_OP_EXTRAARG,
+&&L_OP_MOVE2,
+&&L_OP_GETTABUPF,
+&&L_OP_GETFIELD2,
+&&L_OP_ADDINT,
+&&L_OP_ADDFLT,
+&&L_OP_SUBINT,
+&&L_OP_SUBFLT,
+&&L_OP_MULINT,
+&&L_OP_MULFLT,
+&&L_OP_LTINT,
+&&L_OP_LTFLT
 
 };
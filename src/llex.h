@@ -29,7 +29,7 @@
 * WARNING: if you change the order of this enumeration,
 * grep "ORDER RESERVED"
 */
-// luaֶ
+// lua保留字定义
 enum RESERVED {
   /* terminal symbols denoted by reserved words */
   TK_AND = FIRST_RESERVED, TK_BREAK,
@@ -47,7 +47,7 @@ enum RESERVED {
 #define NUM_RESERVED	(cast_int(TK_WHILE-FIRST_RESERVED + 1))
 
 
-// tokenʵϢ
+// token实际信息
 typedef union {
   lua_Number r;
   lua_Integer i;
@@ -57,43 +57,43 @@ typedef union {
 
 // token
 typedef struct Token {
-  // ͶӦöֵ
+  // 类型对应的枚举值
   int token;
-  // 洢ֵtokenֵ
+  // 存储含有值的token的值
   SemInfo seminfo;
 } Token;
 
 
 /* state of the lexer plus state of the parser when shared by all
    functions */
-// ʷ״̬
+// 词法状态机
 typedef struct LexState {
-  // ǰȡַ
+  // 当前读取的字符
   int current;   /* current character (charint) */
-  // ǰȡ
+  // 当前读取到的行
   int linenumber;  /* input line counter */
-  // һtoken
+  // 上一个token的行
   int lastline;  /* line of last token 'consumed' */
-  // ǰtoken
+  // 当前token
   Token t;  /* current token */
-  // ǰȡtoken
+  // 提前获取的token
   Token lookahead;  /* look ahead token */
-  // ǰĺ
+  // 当前解析的函数
   struct FuncState *fs;  /* current function (parser) */
-  // Ӧlua״̬
+  // 对应的lua状态机
   struct lua_State *L;
-  // ַȡ
+  // 字符流读取器
   ZIO *z;  /* input stream */
-  // ʱtoken
+  // 临时缓冲区，存放完整token
   Mbuffer *buff;  /* buffer for tokens */
-  // ұ泣ӿʱĳңȻҲǱⱻGC
+  // 常量缓存查找表，缓存常量，加快编译时的常量查找，当然也是避免被GC
   // h[k] = index(Proto::k)
   Table *h;  /* to avoid collection/reuse strings */
-  // ﷨УlocalϢ
+  // 语法分析过程中，存放local变量信息
   struct Dyndata *dyd;  /* dynamic structures used by the parser */
-  // ǰԴ
+  // 当前资源名称
   TString *source;  /* current source name */
-  // 
+  // 环境变量名称
   TString *envn;  /* environment variable name */
 } LexState;
 
@@ -94,7 +94,7 @@ static void *firsttry (global_State *g, void *block, size_t os, size_t ns) {
 #define MINSIZEARRAY	4
 
 
-// 
+// 分配数组
 void *luaM_growaux_ (lua_State *L, void *block, int nelems, int *psize,
                      int size_elems, int limit, const char *what) {
   void *newblock;
@@ -148,12 +148,12 @@ l_noret luaM_toobig (lua_State *L) {
 /*
 ** Free memory
 */
-// ͷڴ
+// 释放内存
 void luaM_free_ (lua_State *L, void *block, size_t osize) {
   global_State *g = G(L);
   lua_assert((osize == 0) == (block == NULL));
   callfrealloc(g, block, osize, 0);
-  // ծ
+  // 减少债务
   g->GCdebt -= osize;
 }
 
@@ -193,7 +193,7 @@ void *luaM_realloc_ (lua_State *L, void *block, size_t osize, size_t nsize) {
 }
 
 
-// ȫrellocͱ
+// 安全relloc，错误就报错
 void *luaM_saferealloc_ (lua_State *L, void *block, size_t osize,
                                                     size_t nsize) {
   void *newblock = luaM_realloc_(L, block, osize, nsize);
@@ -203,7 +203,7 @@ void *luaM_saferealloc_ (lua_State *L, void *block, size_t osize,
 }
 
 
-// һСΪsڴռ
+// 分配一块大小为s的内存块空间
 void *luaM_malloc_ (lua_State *L, size_t size, int tag) {
   if (size == 0)
     return NULL;  /* that's all */
@@ -215,7 +215,7 @@ void *luaM_malloc_ (lua_State *L, size_t size, int tag) {
       if (newblock == NULL)
         luaM_error(L);
     }
-    // ծ
+    // 增加债务
     g->GCdebt += size;
     return newblock;
   }
@@ -41,7 +41,7 @@
 ** when multiplied by the size of type 't'. (Assumes that 'n' is an
 ** 'int' or 'unsigned int' and that 'int' is not larger than 'size_t'.)
 */
-// ֹ
+// 防止溢出，如果溢出返回最大承载
 #define luaM_limitN(n,t)  \
   ((cast_sizet(n) <= MAX_SIZET/sizeof(t)) ? (n) :  \
      cast_uint((MAX_SIZET/sizeof(t))))
@@ -58,15 +58,15 @@
 #define luaM_freearray(L, b, n)   luaM_free_(L, (b), (n)*sizeof(*(b)))
 
 #define luaM_new(L,t)		cast(t*, luaM_malloc_(L, sizeof(t), 0))
-// һСΪnڴռ䣬佫ҪɵLuaΪtagʾ
+// 分配一块大小为n的内存块空间，其将要容纳的Lua数据类型为tag表示的类型
 #define luaM_newvector(L,n,t)	cast(t*, luaM_malloc_(L, (n)*sizeof(t), 0))
 #define luaM_newvectorchecked(L,n,t) \
   (luaM_checksize(L,n,sizeof(t)), luaM_newvector(L,n,t))
 
-// һСΪsڴռ䣬佫ҪɵLuaΪtagʾ
+// 分配一块大小为s的内存块空间，其将要容纳的Lua数据类型为tag表示的类型
 #define luaM_newobject(L,tag,s)	luaM_malloc_(L, (s), tag)
 
-// һڴ渳ֵvҪĶΪt
+// 分配连续的一块内存赋值给v，要分配的对象为t，
 #define luaM_growvector(L,v,nelems,size,t,limit,e) \
 	((v)=cast(t *, luaM_growaux_(L,v,nelems,&(size),sizeof(t), \
                          luaM_limitN(limit,t),e)))
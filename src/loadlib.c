@@ -52,6 +52,12 @@
 */
 static const char *const CLIBS = "_CLIBS";
 
+/*
+** key for table in the registry that keeps the directory listings
+** used by 'require' to resolve module names
+*/
+static const char *const PATHCACHE = "_PATHCACHE";
+
 #define LIB_FAIL	"open"
 
 
@@ -165,7 +171,7 @@ static lua_CFunction lsys_sym (lua_State *L, void *lib, const char *sym) {
 ** Replace in the path (on the top of the stack) any occurrence
 ** of LUA_EXEC_DIR with the executable's path.
 */
-// ·еLUA_EXEC_DIR滻ΪִļĿ¼·
+// 将路径中的LUA_EXEC_DIR替换为可执行文件的目录路径
 static void setprogdir (lua_State *L) {
   char buff[MAX_PATH + 1];
   char *lb;
@@ -269,6 +275,14 @@ static lua_CFunction lsys_sym (lua_State *L, void *lib, const char *sym) {
 #define LUA_CPATH_VAR   "LUA_CPATH"
 #endif
 
+/*
+** LUA_CACHEDIR_VAR is the name of the environment variable that gives
+** the directory where 'require' keeps compiled Lua modules.
+*/
+#if !defined(LUA_CACHEDIR_VAR)
+#define LUA_CACHEDIR_VAR	"LUA_CACHEDIR"
+#endif
+
 
 
 /*
@@ -291,49 +305,67 @@ static void setpath (lua_State *L, const char *fieldname,
                                    const char *envname,
                                    const char *dft) {
   const char *dftmark;
-  // ƴӳһ汾ĻѹջУ磺LUA_PATH_5_4
+  // 拼接成一个版本化的环境变量名，并将其压入栈中，例如：LUA_PATH_5_4
   const char *nver = lua_pushfstring(L, "%s%s", envname, LUA_VERSUFFIX);
-  // ȡ
+  // 获取环境变量
   const char *path = getenv(nver);  /* try versioned name */
   if (path == NULL)  /* no versioned environment variable? */
-    // ڣԻȡδ汾Ļ
+    // 不存在，则尝试获取未版本化的环境变量
     path = getenv(envname);  /* try unversioned name */
   if (path == NULL || noenv(L))  /* no environment variable? */
-    // ڻߺԻʹĬϼ
+    // 如果环境变量不存在或者忽略环境变量，使用默认即可
     lua_pushstring(L, dft);  /* use default */
   else if ((dftmark = strstr(path, LUA_PATH_SEP LUA_PATH_SEP)) == NULL)
-    // в;;ֱӽֵѹջ
+    // 如果环境变量中不包含;;，则直接将环境变量的值压入栈中
     lua_pushstring(L, path);  /* nothing to change */
   else {  /* path contains a ";;": insert default path in its place */
-    // ·ַе;;滻ΪĬ·dft
+    // 将路径字符串中的;;，替换为默认路径dft
     size_t len = strlen(path);
     luaL_Buffer b;
     luaL_buffinit(L, &b);
     if (path < dftmark) {  /* is there a prefix before ';;'? */
-      // ˵ǰ׺
-      // ǰ׺ӵb
+      // 说明有前缀
+      // 将前缀部分添加到缓冲区b中
       luaL_addlstring(&b, path, dftmark - path);  /* add it */
-      // ·ָ;
+      // 添加路径分隔符;
       luaL_addchar(&b, *LUA_PATH_SEP);
     }
-    // Ĭ·dftӵb
+    // 将默认路径dft添加到缓冲区b
     luaL_addstring(&b, dft);  /* add default */
     if (dftmark < path + len - 2) {  /* is there a suffix after ';;'? */
-      // ں׺
-      // ·ָ
+      // 存在后缀
+      // 添加路径分隔符
       luaL_addchar(&b, *LUA_PATH_SEP);
-      // ׺ӵb
+      // 将后缀部分添加到缓冲区b
       luaL_addlstring(&b, dftmark + 2, (path + len - 2) - dftmark);
     }
-    // bеݹΪһLuaַѹջ
+    // 将缓冲区b中的内容构建为一个Lua字符串，并将其压入栈中
     luaL_pushresult(&b);
   }
-  // ·LUA_EXEC_DIR滻ΪִļĿ¼·
+  // 将上述路径中LUA_EXEC_DIR替换为可执行文件的目录路径
   setprogdir(L);
   lua_setfield(L, -3, fieldname);  /* package[fieldname] = path value */
   lua_pop(L, 1);  /* pop versioned variable name ('nver') */
 }
 
+
+/*
+** Set 'package.cachedir' from the environment, if there is one to use;
+** otherwise the field stays nil and the bytecode cache is disabled.
+*/
+static void setcachedir (lua_State *L) {
+  const char *nver = lua_pushfstring(L, "%s%s", LUA_CACHEDIR_VAR,
+                                                LUA_VERSUFFIX);
+  const char *dir = getenv(nver);  /* try versioned name */
+  if (dir == NULL)  /* no versioned environment variable? */
+    dir = getenv(LUA_CACHEDIR_VAR);  /* try unversioned name */
+  if (dir != NULL && *dir != '\0' && !noenv(L)) {
+    lua_pushstring(L, dir);
+    lua_setfield(L, -3, "cachedir");
+  }
+  lua_pop(L, 1);  /* pop versioned variable name ('nver') */
+}
+
 /* }================================================================== */
 
 
@@ -368,7 +400,7 @@ static void addtoclib (lua_State *L, const char *path, void *plib) {
 ** __gc tag method for CLIBS table: calls 'lsys_unloadlib' for all lib
 ** handles in list CLIBS
 */
-// CLIBS__gcԪ
+// CLIBS的__gc元方法
 static int gctm (lua_State *L) {
   lua_Integer n = luaL_len(L, 1);
   for (; n >= 1; n--) {  /* for each handle, in reverse order */
@@ -448,6 +480,189 @@ static int readable (const char *filename) {
 }
 
 
+/*
+** {------------------------------------------------------
+** Directory listings for 'require'
+**
+** 'require' probes each template of a search path with 'readable',
+** which costs one failed 'fopen' per template per module. Instead,
+** it lists each directory it looks into once and keeps the names in
+** a table, so that a miss is a 'stat' of the directory and a hash
+** lookup (or only the 'stat', for a directory that does not exist,
+** which is not remembered). The registry table PATHCACHE has the listings (directory ->
+** table of names, or 'false' if the directory does not exist, or
+** 'true' if it cannot be listed) at index 1, and in fields 'path' and
+** 'cpath' the paths the listings were made for; a change in any of
+** them, or a call to 'package.rescan', discards all listings. Each
+** listing keeps at index 1 the modification time of its directory;
+** when a 'stat' shows that the directory changed (or that a missing
+** directory appeared), only that directory is listed again. Times have
+** a resolution of one second, so a listing made in the same second as
+** the last change of its directory is not trusted (a later change in
+** that second would not show) and is made again on next use. File
+** systems with coarser times need 'package.rescan'. Listings assume case-sensitive names; a directory that reports being
+** case-insensitive (where 'pathconf' can tell) is not listed, and its
+** files are probed with 'readable' as before. Other case-insensitive
+** file systems (e.g., casefolded directories on Linux) need file names
+** spelled as in the search path.
+** -------------------------------------------------------
+*/
+
+#if defined(LUA_USE_POSIX)
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <time.h>
+
+#define DIRBOX		"_PATHCACHEDIR"
+
+
+static int dirgc (lua_State *L) {
+  DIR **box = (DIR **)lua_touserdata(L, 1);
+  if (*box != NULL) {
+    closedir(*box);
+    *box = NULL;
+  }
+  return 0;
+}
+
+
+/* push the listing of directory 'dir', whose modification time is 'mt' */
+static void listdir (lua_State *L, const char *dir, lua_Integer mt) {
+  DIR **box = (DIR **)lua_newuserdatauv(L, sizeof(DIR *), 0);
+  struct dirent *e;
+  *box = NULL;
+  if (luaL_newmetatable(L, DIRBOX)) {  /* first use? */
+    lua_pushcfunction(L, dirgc);
+    lua_setfield(L, -2, "__gc");
+  }
+  lua_setmetatable(L, -2);  /* closes the directory in case of errors */
+#if defined(_PC_CASE_SENSITIVE)
+  if (pathconf(dir, _PC_CASE_SENSITIVE) == 0) {  /* case-insensitive? */
+    lua_pushboolean(L, 1);  /* do not list it; try every file */
+    lua_remove(L, -2);  /* remove box */
+    return;
+  }
+#endif
+  *box = opendir(dir);
+  if (*box == NULL)  /* no listing? */
+    lua_pushboolean(L, errno != ENOENT && errno != ENOTDIR);
+  else {
+    lua_newtable(L);
+    if (mt >= (lua_Integer)time(NULL))  /* changed in this very second? */
+      mt = -1;  /* do not trust this listing */
+    lua_pushinteger(L, mt);
+    lua_rawseti(L, -2, 1);  /* names are strings; index 1 is free */
+    while ((e = readdir(*box)) != NULL) {
+      lua_pushboolean(L, 1);
+      lua_setfield(L, -2, e->d_name);
+    }
+    closedir(*box);
+    *box = NULL;
+  }
+  lua_remove(L, -2);  /* remove box */
+}
+
+
+/*
+** Check whether 'filename' may exist, according to the listing of its
+** directory in table 'cache'.
+*/
+static int listed (lua_State *L, int cache, const char *filename) {
+  int top = lua_gettop(L);
+  const char *base = strrchr(filename, *LUA_DIRSEP);
+  const char *dir;
+  struct stat st;
+  int isdir, current, res;
+  lua_Integer mt = 0;
+  base = (base == NULL) ? filename : base + 1;
+  dir = lua_pushlstring(L, filename, base - filename);  /* directory */
+  if (*dir == '\0') dir = ".";
+  if (stat(dir, &st) == 0)
+    isdir = S_ISDIR(st.st_mode);
+  else
+    isdir = (errno != ENOENT && errno != ENOTDIR) ? -1 : 0;
+  if (!isdir) {  /* no such directory? */
+    lua_settop(L, top);  /* no need to remember it */
+    return 0;
+  }
+  if (isdir > 0) mt = (lua_Integer)st.st_mtime;
+  lua_pushvalue(L, -1);
+  switch (lua_rawget(L, cache)) {
+    case LUA_TTABLE:  /* listed; is the listing still current? */
+      current = (isdir > 0 && lua_rawgeti(L, -1, 1) == LUA_TNUMBER &&
+                 lua_tointeger(L, -1) == mt);
+      if (current) lua_pop(L, 1);  /* remove time */
+      break;
+    case LUA_TBOOLEAN:  /* missing or unlistable directory */
+      current = lua_toboolean(L, -1);  /* unlistable? (else it appeared) */
+      break;
+    default: current = 0;  /* not listed yet */
+  }
+  if (!current) {  /* must (re)list the directory? */
+    lua_settop(L, top + 1);
+    listdir(L, dir, mt);
+    lua_pushvalue(L, -2);  /* directory */
+    lua_pushvalue(L, -2);  /* its listing */
+    lua_rawset(L, cache);
+  }
+  if (lua_istable(L, -1))
+    res = (lua_getfield(L, -1, base) != LUA_TNIL);
+  else
+    res = lua_toboolean(L, -1);  /* 'true' means "try it" */
+  lua_settop(L, top);
+  return res;
+}
+
+
+/*
+** Push the table of listings for the path on the top of the stack,
+** kept in field 'pname' of 'package', and return its index.
+*/
+static int pathcache (lua_State *L, const char *pname) {
+  int path = lua_gettop(L);
+  if (lua_getfield(L, LUA_REGISTRYINDEX, PATHCACHE) != LUA_TTABLE) {
+    lua_pop(L, 1);
+    lua_createtable(L, 1, 2);
+    lua_newtable(L);  /* no listings yet */
+    lua_rawseti(L, -2, 1);
+    lua_pushvalue(L, -1);
+    lua_setfield(L, LUA_REGISTRYINDEX, PATHCACHE);
+  }
+  lua_getfield(L, -1, pname);  /* path of current listings */
+  if (!lua_rawequal(L, -1, path)) {  /* first use or path has changed? */
+    if (!lua_isnil(L, -1)) {  /* changed? */
+      lua_newtable(L);  /* discard all listings */
+      lua_rawseti(L, -3, 1);
+    }
+    lua_pushvalue(L, path);
+    lua_setfield(L, -3, pname);
+  }
+  lua_pop(L, 1);
+  lua_rawgeti(L, -1, 1);
+  lua_remove(L, -2);  /* remove PATHCACHE table */
+  return lua_gettop(L);
+}
+
+#else
+
+#define listed(L,c,f)		((void)(L), (void)(c), (void)(f), 1)
+#define pathcache(L,p)		((void)(p), 0)
+
+#endif
+
+
+static int ll_rescan (lua_State *L) {
+  lua_pushnil(L);
+  lua_setfield(L, LUA_REGISTRYINDEX, PATHCACHE);
+  return 0;
+}
+
+/* }------------------------------------------------------ */
+
+
 /*
 ** Get the next name in '*path' = 'name1;name2;name3;...', changing
 ** the ending ';' to '\0' to create a zero-terminated string. Return
@@ -487,10 +702,16 @@ static void pusherrornotfound (lua_State *L, const char *path) {
 }
 
 
+/*
+** Search for 'name' in 'path'. If 'cache' is not 0, it is the index of
+** a table of directory listings, and only the files listed there are
+** probed.
+*/
 static const char *searchpath (lua_State *L, const char *name,
                                              const char *path,
                                              const char *sep,
-                                             const char *dirsep) {
+                                             const char *dirsep,
+                                             int cache) {
   luaL_Buffer buff;
   char *pathname;  /* path with name inserted */
   char *endpathname;  /* its end */
@@ -505,7 +726,8 @@ static const char *searchpath (lua_State *L, const char *name,
   pathname = luaL_buffaddr(&buff);  /* writable list of file names */
   endpathname = pathname + luaL_bufflen(&buff) - 1;
   while ((filename = getnextfilename(&pathname, endpathname)) != NULL) {
-    if (readable(filename))  /* does file exist and is readable? */
+    if ((cache == 0 || listed(L, cache, filename)) &&
+        readable(filename))  /* does file exist and is readable? */
       return lua_pushstring(L, filename);  /* save and return name */
   }
   luaL_pushresult(&buff);  /* push path to create error message */
@@ -518,7 +740,7 @@ static int ll_searchpath (lua_State *L) {
   const char *f = searchpath(L, luaL_checkstring(L, 1),
                                 luaL_checkstring(L, 2),
                                 luaL_optstring(L, 3, "."),
-                                luaL_optstring(L, 4, LUA_DIRSEP));
+                                luaL_optstring(L, 4, LUA_DIRSEP), 0);
   if (f != NULL) return 1;
   else {  /* error message is on top of the stack */
     luaL_pushfail(L);
@@ -536,7 +758,7 @@ static const char *findfile (lua_State *L, const char *name,
   path = lua_tostring(L, -1);
   if (l_unlikely(path == NULL))
     luaL_error(L, "'package.%s' must be a string", pname);
-  return searchpath(L, name, path, ".", dirsep);
+  return searchpath(L, name, path, ".", dirsep, pathcache(L, pname));
 }
 
 
@@ -551,13 +773,229 @@ static int checkload (lua_State *L, int stat, const char *filename) {
 }
 
 
-// ģָ·вҶӦLuaļԼظļ
+
+/*
+** {======================================================
+** Bytecode cache for Lua modules
+** =======================================================
+*/
+
+#if defined(LUA_USE_POSIX)	/* { */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+** A cache entry is a header line followed by the dumped chunk. The
+** header records the size, modification time and a hash of the contents
+** of the source file, plus its name; an entry is used only when its
+** header matches the source as it is now. The header only proves that
+** an entry is fresh, not who wrote it, and malformed bytecode is not
+** safe to load; so the cache directory must belong to the effective
+** user and not be writable by anyone else, and so must its entries.
+*/
+#define CACHEMAGIC	"#luacache " LUA_VERSION_MAJOR LUA_VERSION_MINOR " "
+
+#define FNVBASIS	2166136261u
+
+/* 32-bit FNV-1a hash of 's', continuing from 'h' */
+static unsigned int fnvhash (unsigned int h, const char *s, size_t l) {
+  size_t i;
+  for (i = 0; i < l; i++)
+    h = (h ^ (unsigned char)s[i]) * 16777619u;
+  return h;
+}
+
+
+/*
+** Push the header that a valid cache entry for 'filename' must start
+** with. Returns 0 (pushing nothing) if the source cannot be read or
+** changes while being read.
+*/
+static int cacheheader (lua_State *L, const char *filename) {
+  char buff[LUAL_BUFFERSIZE];
+  struct stat st;
+  unsigned int h = FNVBASIS;
+  size_t n, total = 0;
+  int ok;
+  FILE *f = fopen(filename, "rb");
+  if (f == NULL) return 0;
+  ok = (fstat(fileno(f), &st) == 0);
+  while (ok && (n = fread(buff, 1, sizeof(buff), f)) > 0) {
+    h = fnvhash(h, buff, n);
+    total += n;
+  }
+  ok = ok && !ferror(f) && total == (size_t)st.st_size;
+  fclose(f);
+  if (!ok) return 0;
+  lua_pushfstring(L, CACHEMAGIC "%I %I %I %s\n", (lua_Integer)st.st_size,
+                  (lua_Integer)st.st_mtime, (lua_Integer)h, filename);
+  return 1;
+}
+
+
+/* check whether only the effective user can write in 'st' */
+static int ownedonly (const struct stat *st) {
+  return (st->st_uid == geteuid() && (st->st_mode & (S_IWGRP|S_IWOTH)) == 0);
+}
+
+
+/* check whether 'dir' can be trusted as a cache directory */
+static int safecachedir (const char *dir) {
+  struct stat st;
+  return (stat(dir, &st) == 0 && S_ISDIR(st.st_mode) && ownedonly(&st));
+}
+
+
+/* push the name of the cache entry for 'filename' in directory 'dir' */
+static const char *cachename (lua_State *L, const char *dir,
+                                            const char *filename) {
+  char hex[16];
+  l_sprintf(hex, sizeof(hex), "%08x",
+            fnvhash(FNVBASIS, filename, strlen(filename)));
+  return lua_pushfstring(L, "%s" LUA_DIRSEP "%s.luac", dir, hex);
+}
+
+
+/*
+** Try to load the cache entry 'cname', which must start with 'header'.
+** On success pushes the function and returns 1; otherwise returns 0
+** with the stack unchanged.
+*/
+static int loadcache (lua_State *L, const char *cname, const char *header) {
+  int top = lua_gettop(L);
+  size_t hl = strlen(header);
+  struct stat st;
+  char *img;
+  size_t n;
+  FILE *f;
+  if (stat(cname, &st) != 0 || (size_t)st.st_size <= hl)
+    return 0;  /* no entry */
+  n = (size_t)st.st_size;
+  img = (char *)lua_newuserdatauv(L, n, 0);  /* allocate before opening */
+  f = fopen(cname, "rb");
+  if (f != NULL) {
+    int ok = (fstat(fileno(f), &st) == 0 && S_ISREG(st.st_mode) &&
+              ownedonly(&st) && (size_t)st.st_size == n &&
+              fread(img, 1, n, f) == n);
+    fclose(f);
+    if (ok && memcmp(img, header, hl) == 0 &&
+        luaL_loadbufferx(L, img + hl, n - hl, cname, "b") == LUA_OK) {
+      lua_replace(L, top + 1);  /* function replaces the image */
+      return 1;
+    }
+  }
+  lua_settop(L, top);  /* remove image (and error message) */
+  return 0;
+}
+
+
+/*
+** Buffer for the dump of a module; it is initialized (with the header)
+** on the first call to 'cachewriter', when the function is no longer
+** needed on the top of the stack.
+*/
+typedef struct CacheWriter {
+  int init;  /* true iff buffer has been initialized */
+  const char *header;
+  luaL_Buffer B;
+} CacheWriter;
+
+
+static int cachewriter (lua_State *L, const void *b, size_t size,
+                                      void *ud) {
+  CacheWriter *state = (CacheWriter *)ud;
+  if (!state->init) {
+    state->init = 1;
+    luaL_buffinit(L, &state->B);
+    luaL_addstring(&state->B, state->header);
+  }
+  luaL_addlstring(&state->B, (const char *)b, size);
+  return 0;
+}
+
+
+#define TMPSUFFIX	".XXXXXX"
+
+/*
+** Store the function on the top of the stack as the cache entry 'cname'.
+** The entry is written to a new temporary file (created by 'mkstemp',
+** so it cannot be a file or link planted there) and then renamed over
+** the old one, so that concurrent processes never see a partial entry.
+** The cache is only a hint: any failure leaves it as it was.
+*/
+static void storecache (lua_State *L, const char *cname, const char *header) {
+  int top = lua_gettop(L);
+  CacheWriter state;
+  size_t l = strlen(cname);
+  char *tmpname = (char *)lua_newuserdatauv(L, l + sizeof(TMPSUFFIX), 0);
+  size_t n;
+  const char *img;
+  int fd;
+  memcpy(tmpname, cname, l);
+  memcpy(tmpname + l, TMPSUFFIX, sizeof(TMPSUFFIX));
+  state.init = 0;
+  state.header = header;
+  lua_pushvalue(L, top);  /* function to be dumped */
+  if (lua_dump(L, cachewriter, &state, 0) == 0 && state.init) {
+    luaL_pushresult(&state.B);
+    img = lua_tolstring(L, -1, &n);
+    fd = mkstemp(tmpname);
+    if (fd >= 0) {
+      FILE *f = fdopen(fd, "wb");
+      int ok = (f != NULL && fwrite(img, 1, n, f) == n);
+      ok = ((f != NULL) ? fclose(f) == 0 : close(fd) == 0) && ok;
+      if (!ok || rename(tmpname, cname) != 0)
+        remove(tmpname);  /* do not leave garbage behind */
+    }
+  }
+  lua_settop(L, top);
+}
+
+
+/*
+** Load the Lua module 'filename', going through the bytecode cache in
+** 'package.cachedir' when it is set (and safe). On success the function
+** is on the top; otherwise, as 'luaL_loadfile', the error message.
+*/
+static int loadmodule (lua_State *L, const char *filename) {
+  int top = lua_gettop(L);
+  const char *dir, *header, *cname;
+  int status = LUA_OK;
+  lua_getfield(L, lua_upvalueindex(1), "cachedir");
+  dir = lua_tostring(L, -1);
+  if (dir == NULL || !safecachedir(dir) ||  /* no (usable) cache? */
+      !cacheheader(L, filename)) {
+    lua_settop(L, top);
+    return luaL_loadfile(L, filename);
+  }
+  header = lua_tostring(L, -1);
+  cname = cachename(L, dir, filename);
+  // 缓存不存在或者已经失效，重新编译，并写回缓存
+  if (!loadcache(L, cname, header) &&
+      (status = luaL_loadfile(L, filename)) == LUA_OK)
+    storecache(L, cname, header);
+  lua_replace(L, top + 1);  /* function or error message */
+  lua_settop(L, top + 1);
+  return status;
+}
+
+#else				/* }{ */
+
+#define loadmodule(L,f)		luaL_loadfile(L, f)
+
+#endif				/* } */
+
+/* }====================================================== */
+
+
+// 根据模块名在指定的路径中查找对应的Lua文件，并尝试加载该文件
 static int searcher_Lua (lua_State *L) {
   const char *filename;
   const char *name = luaL_checkstring(L, 1);
   filename = findfile(L, name, "path", LUA_LSUBSEP);
   if (filename == NULL) return 1;  /* module not found in this path */
-  return checkload(L, (luaL_loadfile(L, filename) == LUA_OK), filename);
+  return checkload(L, (loadmodule(L, filename) == LUA_OK), filename);
 }
 
 
@@ -587,7 +1025,7 @@ static int loadfunc (lua_State *L, const char *filename, const char *modname) {
 }
 
 
-// ģָ·вҶӦCļԼظÿ
+// 根据模块名在指定的路径中查找对应的C库文件，并尝试加载该库
 static int searcher_C (lua_State *L) {
   const char *name = luaL_checkstring(L, 1);
   const char *filename = findfile(L, name, "cpath", LUA_CSUBSEP);
@@ -596,7 +1034,7 @@ static int searcher_C (lua_State *L) {
 }
 
 
-// ģƲҲضӦCģļģںעᵽLua
+// 根据模块名称查找并加载对应的C模块文件，并将模块的入口函数注册到Lua环境中
 static int searcher_Croot (lua_State *L) {
   const char *filename;
   const char *name = luaL_checkstring(L, 1);
@@ -619,7 +1057,7 @@ static int searcher_Croot (lua_State *L) {
 }
 
 
-// ڴԤرpackage.preloadвָģ飬ҵӦģ飬ģһʶδҵ򷵻һϢ
+// 用于从预加载表（package.preload）中查找指定模块，如果找到对应的模块，返回模块和一个标识符；如果未找到，则返回一个错误信息
 static int searcher_preload (lua_State *L) {
   const char *name = luaL_checkstring(L, 1);
   lua_getfield(L, LUA_REGISTRYINDEX, LUA_PRELOAD_TABLE);
@@ -634,37 +1072,37 @@ static int searcher_preload (lua_State *L) {
 }
 
 
-// package.searchersеΪָģҵһʵļҲ׳
+// 遍历package.searchers表中的搜索器，尝试为指定的模块名称找到一个合适的加载器，如果找不到加载器，则会抛出错误
 static void findloader (lua_State *L, const char *name) {
   int i;
-  // ڹϢ
+  // 用于构建错误消息
   luaL_Buffer msg;  /* to build error message */
-  // ֵpackageлȡsearchersջ
+  // 从上值package中获取searchers表，放入栈中
   /* push 'package.searchers' to index 3 in the stack */
   if (l_unlikely(lua_getfield(L, lua_upvalueindex(1), "searchers")
                  != LUA_TTABLE))
     luaL_error(L, "'package.searchers' must be a table");
-  // ʼmsgջ
+  // 初始化msg，放入栈中
   luaL_buffinit(L, &msg);
   /*  iterate over available searchers to find a loader */
-  // searchers
+  // 遍历searchers表
   for (i = 1; ; i++) {
     luaL_addstring(&msg, "\n\t");  /* error-message prefix */
     if (l_unlikely(lua_rawgeti(L, 3, i) == LUA_TNIL)) {  /* no more searchers? */
-      // ˵ûиˣƳnil
+      // 说明没有更多搜索了，移除nil
       lua_pop(L, 1);  /* remove nil */
-      // Ƴǰ׺
+      // 移除前缀
       luaL_buffsub(&msg, 2);  /* remove prefix */
-      // Ϣջ
+      // 将错误消息放入栈中
       luaL_pushresult(&msg);  /* create error message */
-      // ׳
+      // 抛出错误
       luaL_error(L, "module '%s' not found:%s", name, lua_tostring(L, -1));
     }
-    // ģѹջУΪĲ
+    // 将模块名压入栈中，作为搜索器的参数
     lua_pushstring(L, name);
-    // ֵͼݣ
+    // 调用搜索器，期望返回两个值（加载器函数和加载数据）
     lua_call(L, 1, 2);  /* call it */
-    // Ƿҵ
+    // 是否找到加载器
     if (lua_isfunction(L, -2))  /* did it find a loader? */
       return;  /* module loader found */
     else if (lua_isstring(L, -2)) {  /* searcher returned error message? */
@@ -679,34 +1117,34 @@ static void findloader (lua_State *L, const char *name) {
 }
 
 
-// ģƼģ鲢仺浽package.loaded
+// 根据模块名称加载模块并将其缓存到package.loaded表中
 static int ll_require (lua_State *L) {
-  // ȡģ
+  // 获取模块名
   const char *name = luaL_checkstring(L, 1);
-  // ջΪ1ȷջֻģ
+  // 将栈顶设置为索引1，确保栈中只有模块名
   lua_settop(L, 1);  /* LOADED table will be at index 2 */
-  // ȫ_LOADEDвģ
+  // 从全局_LOADED表中查找模块
   lua_getfield(L, LUA_REGISTRYINDEX, LUA_LOADED_TABLE);
   lua_getfield(L, 2, name);  /* LOADED[name] */
   if (lua_toboolean(L, -1))  /* is it there? */
     return 1;  /* package is already loaded */
   /* else must load package */
   lua_pop(L, 1);  /* remove 'getfield' result */
-  // ûҵ
-  // ģļѹջ
+  // 没找到
+  // 查找模块的加载器，并将其压入栈中
   findloader(L, name);
   lua_rotate(L, -2, 1);  /* function <-> loader data */
   lua_pushvalue(L, 1);  /* name is 1st argument to module loader */
   lua_pushvalue(L, -3);  /* loader data is 2nd argument */
   /* stack: ...; loader data; loader function; mod. name; loader data */
-  // üģƺͼݣһֵؽ
+  // 调用加载器函数，传入两个参数（模块名称和加载器数据），并期望返回一个值（加载结果）
   lua_call(L, 2, 1);  /* run loader to load module */
   /* stack: ...; loader data; result from loader */
   if (!lua_isnil(L, -1))  /* non-nil return? */
     lua_setfield(L, 2, name);  /* LOADED[name] = returned value */
   else
     lua_pop(L, 1);  /* pop nil */
-  // package.loaded[name]Ϊnil
+  // package.loaded[name]为nil
   if (lua_getfield(L, 2, name) == LUA_TNIL) {   /* module set no value? */
     lua_pushboolean(L, 1);  /* use true as result */
     lua_copy(L, -1, -2);  /* replace loader result */
@@ -724,6 +1162,7 @@ static int ll_require (lua_State *L) {
 static const luaL_Reg pk_funcs[] = {
   {"loadlib", ll_loadlib},
   {"searchpath", ll_searchpath},
+  {"rescan", ll_rescan},
   /* placeholders */
   {"preload", NULL},
   {"cpath", NULL},
@@ -740,8 +1179,8 @@ static const luaL_Reg ll_funcs[] = {
 };
 
 
-// ʼLuaеpackage.searchersΪһԤģ
-// Щڵrequireʱ˳Һͼģ 
+// 初始化Lua中的package.searchers表，并将其填充为一组预定义的模块加载器，
+// 这些加载器用于在调用require函数时按顺序查找和加载模块 
 static void createsearcherstable (lua_State *L) {
   static const lua_CFunction searchers[] = {
     searcher_preload,
@@ -754,9 +1193,9 @@ static void createsearcherstable (lua_State *L) {
   /* create 'searchers' table */
   lua_createtable(L, sizeof(searchers)/sizeof(searchers[0]) - 1, 0);
   /* fill it with predefined searchers */
-  // searchers飬ÿװΪһհ
+  // 遍历searchers数组，将每个加载器函数封装为一个闭包，并将其存入表中
   for (i=0; searchers[i] != NULL; i++) {
-    // packageΪֵݸԱǿԷ package صϢ
+    // 将package表作为上值传递给加载器函数，以便它们可以访问 package 相关的信息
     lua_pushvalue(L, -2);  /* set 'package' as upvalue for all searchers */
     lua_pushcclosure(L, searchers[i], 1);
     // 'searchers' table[i] = cclousure
@@ -771,56 +1210,57 @@ static void createsearcherstable (lua_State *L) {
 ** create table CLIBS to keep track of loaded C libraries,
 ** setting a finalizer to close all libraries when closing state.
 */
-// һΪCLIBSıڸѼصC⣬һսfinalizer
-// Ա Lua ״̬رʱرѼص C 
+// 创建了一个名为CLIBS的表，用于跟踪所有已加载的C库，并设置了一个终结器（finalizer），
+// 以便在 Lua 状态关闭时关闭所有已加载的 C 库
 static void createclibstable (lua_State *L) {
-  // g->l_registry["_CLIBS"] = {}ջ{}
+  // g->l_registry["_CLIBS"] = {}，栈顶就是这个{}
   luaL_getsubtable(L, LUA_REGISTRYINDEX, CLIBS);  /* create CLIBS table */
-  // Ԫ
+  // 元表
   lua_createtable(L, 0, 1);  /* create metatable for CLIBS */
-  // __gcӦĺ
+  // __gc对应的函数
   lua_pushcfunction(L, gctm);
-  // ԪԪ
+  // 设置元表元方法
   lua_setfield(L, -2, "__gc");  /* set finalizer for CLIBS table */
-  // ڸg->l_registry["_CLIBS"] = {}Ԫ
+  // 现在给g->l_registry["_CLIBS"] = {}设置元表吧
   lua_setmetatable(L, -2);
 }
 
 
-// ʼpackageģ·Ϣ
+// 初始化package表，并设置模块加载所需的路径和配置信息
 LUAMOD_API int luaopen_package (lua_State *L) {
-  // CLIBSջ
+  // 创建CLIBS，在栈顶
   createclibstable(L);
-  // һչtablepf_funcsչõ
+  // 创建一个扩展table，把pf_funcs扩展函数设置到里面
   luaL_newlib(L, pk_funcs);  /* create 'package' table */
-  // searchersģڲҺͼģ
-  // 䵽package[searchers] = searchers
+  // 创建searchers表，表包含了模块加载器的搜索函数，用于查找和加载模块
+  // 填充到package[searchers] = searchers表
   createsearcherstable(L);
   /* set paths */
-  // package[path] = ·
+  // package[path] = 路径
   setpath(L, "path", LUA_PATH_VAR, LUA_PATH_DEFAULT);
-  // package[cpath] = ·
+  // package[cpath] = 路径
   setpath(L, "cpath", LUA_CPATH_VAR, LUA_CPATH_DEFAULT);
+  setcachedir(L);
   /* store config information */
-  // LUA_DIRSEPĿ¼ָ/\
-  // LUA_PATH_SEP·ָ;
-  // LUA_PATH_MARK·ǣ?
-  // LUA_EXEC_DIRִļĿ¼ǣ!
-  // UA_IGMARKԱǣ-
+  // LUA_DIRSEP：目录分隔符，/或\
+  // LUA_PATH_SEP：路径分隔符，;
+  // LUA_PATH_MARK：路径标记，?
+  // LUA_EXEC_DIR：可执行文件目录标记，!
+  // UA_IGMARK：忽略标记，-
   lua_pushliteral(L, LUA_DIRSEP "\n" LUA_PATH_SEP "\n" LUA_PATH_MARK "\n"
                      LUA_EXEC_DIR "\n" LUA_IGMARK "\n");
-  // LuaϢ·ָ·ǵȣ洢package.configֶ
-  // package[config] = 
+  // 将Lua的配置信息（如路径分隔符、路径标记等）存储到package.config字段中
+  // package[config] = 配置
   lua_setfield(L, -2, "config");
   /* set field 'loaded' */
   luaL_getsubtable(L, LUA_REGISTRYINDEX, LUA_LOADED_TABLE);
-  // package[config] = Ѽصģ
+  // package[config] = 已加载的模块表
   lua_setfield(L, -2, "loaded");
   /* set field 'preload' */
   luaL_getsubtable(L, LUA_REGISTRYINDEX, LUA_PRELOAD_TABLE);
-  // package[config] = Ԥصģ
+  // package[config] = 预加载的模块表
   lua_setfield(L, -2, "preload");
-  // дĿǣ_G[require] = {ֵpackage}
+  // 下面三行代码目的是：_G[require] = {上值是package}
   lua_pushglobaltable(L);
   lua_pushvalue(L, -2);  /* set 'package' as upvalue for next lib */
   luaL_setfuncs(L, ll_funcs, 1);  /* open lib into global table */
@@ -32,7 +32,7 @@
 /*
 ** Computes ceil(log2(x))
 */
-// ټlog2xȡ
+// 快速计算log2x，向上取整
 int luaO_ceillog2 (unsigned int x) {
   static const lu_byte log_2[256] = {  /* log_2[i] = ceil(log2(i - 1)) */
     0,1,2,2,3,3,3,3,4,4,4,4,4,4,4,4,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,5,
@@ -51,7 +51,7 @@ int luaO_ceillog2 (unsigned int x) {
 }
 
 
-// ִ
+// 用于执行整数的算术运算
 static lua_Integer intarith (lua_State *L, int op, lua_Integer v1,
                                                    lua_Integer v2) {
   switch (op) {
@@ -72,7 +72,7 @@ static lua_Integer intarith (lua_State *L, int op, lua_Integer v1,
 }
 
 
-// ִи
+// 用于执行浮点数的算术运算
 static lua_Number numarith (lua_State *L, int op, lua_Number v1,
                                                   lua_Number v2) {
   switch (op) {
@@ -89,14 +89,14 @@ static lua_Number numarith (lua_State *L, int op, lua_Number v1,
 }
 
 
-// ִԭʼ
+// 执行原始算术操作
 int luaO_rawarith (lua_State *L, int op, const TValue *p1, const TValue *p2,
                    TValue *res) {
   switch (op) {
     case LUA_OPBAND: case LUA_OPBOR: case LUA_OPBXOR:
     case LUA_OPSHL: case LUA_OPSHR:
     case LUA_OPBNOT: {  /* operate only on integers */
-      // ڰλ簴λ롢ơơλȡҪ
+      // 对于按位操作（如按位与、或、异或、左移、右移、按位取反），要求操作数必须是整数
       lua_Integer i1; lua_Integer i2;
       if (tointegerns(p1, &i1) && tointegerns(p2, &i2)) {
         setivalue(res, intarith(L, op, i1, i2));
@@ -105,7 +105,7 @@ int luaO_rawarith (lua_State *L, int op, const TValue *p1, const TValue *p2,
       else return 0;  /* fail */
     }
     case LUA_OPDIV: case LUA_OPPOW: {  /* operate only on floats */
-      // ڸ㣩ҪǸ
+      // 对于浮点数操作（如除法和幂运算），要求操作数必须是浮点数
       lua_Number n1; lua_Number n2;
       if (tonumberns(p1, n1) && tonumberns(p2, n2)) {
         setfltvalue(res, numarith(L, op, n1, n2));
@@ -114,7 +114,7 @@ int luaO_rawarith (lua_State *L, int op, const TValue *p1, const TValue *p2,
       else return 0;  /* fail */
     }
     default: {  /* other operations */
-      // ӷ˷ȣȳʹ
+      // 对于其他操作（如加法、减法、乘法等），优先尝试使用整数运算
       lua_Number n1; lua_Number n2;
       if (ttisinteger(p1) && ttisinteger(p2)) {
         setivalue(res, intarith(L, op, ivalue(p1), ivalue(p2)));
@@ -139,7 +139,7 @@ void luaO_arith (lua_State *L, int op, const TValue *p1, const TValue *p2,
 }
 
 
-// ڽʮַתΪӦֵ
+// 用于将单个十六进制字符转换为其对应的整数值
 int luaO_hexavalue (int c) {
   if (lisdigit(c)) return c - '0';
   else return (ltolower(c) - 'a') + 10;
@@ -328,7 +328,7 @@ size_t luaO_str2num (const char *s, TValue *o) {
 }
 
 
-// UnicodeתɶӦUTF-8ʽ洢ṩַ buff 
+// Unicode码点转换成对应的UTF-8编码格式，并存储到提供的字符数组 buff 中
 int luaO_utf8esc (char *buff, unsigned long x) {
   int n = 1;  /* number of bytes put in buffer (backwards) */
   lua_assert(x <= 0x7FFFFFFFu);
@@ -502,7 +502,7 @@ typedef struct TString {
   // TString为短字符串时：当extra=0时表示它是普通字符串；当extra不为0时，它⼀般是lua保留字。
   lu_byte extra;  /* reserved words for short strings; "has hash" for longs */
   // 短字符串长度
-  lu_byte shrlen;  /* length for short strings, 0xFF for long strings */
+  lu_byte shrlen;  /* length for short strings, LSTRREG/LSTRMEM for long */
   // 字符串哈希值
   unsigned int hash;
   // 这是⼀个union结构。当TString为短字符串时，hnext域有效。当全局字符串表有其他字
@@ -523,15 +523,39 @@ typedef struct TString {
 ** Get the actual string (array of bytes) from a 'TString'. (Generic
 ** version and specialized versions for long and short strings.)
 */
+/*
+** Kinds of long strings, stored in 'shrlen': a regular long string
+** keeps its contents after the header; an external one (created by
+** 'lua_pushexternalstring') keeps there an 'ExtString', pointing to
+** memory owned by the host or to part of another string ('owner'),
+** which it keeps alive.
+*/
+#define LSTRREG		0xFF	/* regular long string */
+#define LSTRMEM		0xFE	/* external long string */
+
+#define isshrlen(ts)	((ts)->shrlen < LSTRMEM)
+
+// 外部字符串：内容由宿主程序持有，被回收时调用falloc释放
+typedef struct ExtString {
+  char *s;  /* contents (with a '\0' at position 'lnglen') */
+  lua_Alloc falloc;  /* function to release the contents (or NULL) */
+  void *ud;  /* user data for 'falloc' */
+  // 内容所在的字符串(切片)，GC标记本字符串时一并标记它
+  struct TString *owner;  /* string holding the contents (or NULL) */
+} ExtString;
+
+#define isextstr(ts)	((ts)->shrlen == LSTRMEM)
+#define extstr(ts)	check_exp(isextstr(ts), cast(ExtString *, (ts)->contents))
+
 // 获取内容
-#define getstr(ts)	((ts)->contents)
-#define getlngstr(ts)	check_exp((ts)->shrlen == 0xFF, (ts)->contents)
-#define getshrstr(ts)	check_exp((ts)->shrlen != 0xFF, (ts)->contents)
+#define getstr(ts)	(isextstr(ts) ? extstr(ts)->s : (ts)->contents)
+#define getlngstr(ts)	check_exp(!isshrlen(ts), getstr(ts))
+#define getshrstr(ts)	check_exp(isshrlen(ts), (ts)->contents)
 
 
 /* get string length from 'TString *s' */
 #define tsslen(s)  \
-	((s)->shrlen != 0xFF ? (s)->shrlen : (s)->u.lnglen)
+	(isshrlen(s) ? (s)->shrlen : (s)->u.lnglen)
 
 /* }================================================================== */
 
@@ -714,6 +738,12 @@ typedef struct AbsLineInfo {
 // 字节码是⼀种能够被虚拟机识别的中间代码。⼀些解释型语⾔，
 // 能够通过它们的编译器将源代码编译成字节码，再交给虚拟机去执⾏。
 // ⼀个Lua函数对应⼀个Proto实例
+/* bits in 'Proto.flag' */
+// lineinfo直接引用了加载时的固定缓冲区(见lua_load的模式'B')，不能释放
+#define PF_FIXED	1	/* 'lineinfo' points into a fixed buffer */
+// 尚未加载的嵌套函数，第一次创建闭包时才从lazy处加载
+#define PF_LAZY		2	/* not loaded yet; its dump is at 'lazy' */
+
 typedef struct Proto {
   // GC公共定义
   CommonHeader;
@@ -723,6 +753,8 @@ typedef struct Proto {
   lu_byte is_vararg;
   // Proto实例所对应函数栈空间的⼤⼩
   lu_byte maxstacksize;  /* number of registers needed by this function */
+  // PF_*标记位
+  lu_byte flag;  /* PF_* bits */
   // UpValue的数量
   int sizeupvalues;  /* size of 'upvalues' */
   // 常量的数量
@@ -741,10 +773,18 @@ typedef struct Proto {
   int linedefined;  /* debug information  */
   // 函数的结束行
   int lastlinedefined;  /* debug information  */
+  // 延迟加载时，函数在固定缓冲区中的dump数据
+  const char *lazy;  /* dump of a function not loaded yet (PF_LAZY) */
+  size_t sizelazy;  /* size of 'lazy' */
+  // 'lineinfo'或'lazy'所在的固定缓冲区字符串，保证它和原型活得一样久
+  struct TString *image;  /* string holding 'lineinfo'/'lazy' (or NULL) */
   // 常量所存储在的数组
   TValue *k;  /* constants used by the function */
   // 指令码数组
   Instruction *code;  /* opcodes */
+  // 指令的内联缓存，与code一一对应，大小也是sizecode
+  // 字段访问指令缓存节点下标，特化过的算术指令记录退化次数
+  unsigned int *icache;  /* inline caches for field accesses (one per opcode) */
   // 函数内部又定义了的其它函数，所以说Lua的函数支持嵌套定义
   struct Proto **p;  /* functions defined inside the function */
   // UpValue的信息
@@ -975,6 +1015,14 @@ typedef union Node {
 // 将flags的第8位设置为1，表示alimit不是数组的实际长度，而是表数组部分的边界
 #define setnorealasize(t)	((t)->flags |= BITRAS)
 
+/*
+** Bit 6 of 'flags' tells whether the table has a card table (which is
+** kept in 'global_State.cards', see 'luaC_newcards').
+*/
+// 第7位为1表示该表有卡表
+#define BITCARDS	(1 << 6)
+#define hascards(t)	((t)->flags & BITCARDS)
+
 
 // lua table 实现
 typedef struct Table {
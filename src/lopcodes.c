@@ -15,7 +15,7 @@
 
 /* ORDER OP */
 
-// ָϸһһӳ
+// 对指令更加详细的描述，一一映射表
 LUAI_DDEF const lu_byte luaP_opmodes[NUM_OPCODES] = {
 /*       MM OT IT T  A  mode		   opcode  */
   opmode(0, 0, 0, 0, 1, iABC)		/* OP_MOVE */
@@ -101,5 +101,64 @@ LUAI_DDEF const lu_byte luaP_opmodes[NUM_OPCODES] = {
  ,opmode(0, 1, 0, 0, 1, iABC)		/* OP_VARARG */
  ,opmode(0, 0, 1, 0, 1, iABC)		/* OP_VARARGPREP */
  ,opmode(0, 0, 0, 0, 0, iAx)		/* OP_EXTRAARG */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_MOVE2 */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_GETTABUPF */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_GETFIELD2 */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_ADDINT */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_ADDFLT */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_SUBINT */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_SUBFLT */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_MULINT */
+ ,opmode(0, 0, 0, 0, 1, iABC)		/* OP_MULFLT */
+ ,opmode(0, 0, 0, 1, 0, iABC)		/* OP_LTINT */
+ ,opmode(0, 0, 0, 1, 0, iABC)		/* OP_LTFLT */
 };
 
+
+/* basic opcode of each fused or quickened opcode */
+LUAI_DDEF const lu_byte luaP_opbase[NUM_OPCODES - NUM_BASEOPCODES] = {
+  OP_MOVE		/* OP_MOVE2 */
+ ,OP_GETTABUP		/* OP_GETTABUPF */
+ ,OP_GETFIELD		/* OP_GETFIELD2 */
+ ,OP_ADD		/* OP_ADDINT */
+ ,OP_ADD		/* OP_ADDFLT */
+ ,OP_SUB		/* OP_SUBINT */
+ ,OP_SUB		/* OP_SUBFLT */
+ ,OP_MUL		/* OP_MULINT */
+ ,OP_MUL		/* OP_MULFLT */
+ ,OP_LT		/* OP_LTINT */
+ ,OP_LT		/* OP_LTFLT */
+};
+
+
+/*
+** Peephole pass over the final code of a function: replace the first
+** instruction of common pairs with the fused opcode that also does the
+** second one. Any previous fusion is undone first, so the pass can run
+** over code of any origin (e.g., a loaded binary chunk).
+*/
+// 窥孔优化：把常见的指令对的第一条替换为融合指令，减少分派次数
+void luaP_fuse (Instruction *code, int n) {
+  int i;
+  for (i = 0; i < n; i++)  /* back to basic (and generic) opcodes */
+    SET_OPCODE(code[i], GET_BASEOPCODE(code[i]));
+  for (i = 0; i + 1 < n; i++) {
+    OpCode next = GET_OPCODE(code[i + 1]);
+    switch (GET_OPCODE(code[i])) {
+      case OP_MOVE:
+        if (next == OP_MOVE)
+          SET_OPCODE(code[i], OP_MOVE2);
+        break;
+      case OP_GETTABUP:  /* e.g., 'math.floor' */
+        if (next == OP_GETFIELD)
+          SET_OPCODE(code[i], OP_GETTABUPF);
+        break;
+      case OP_GETFIELD:  /* e.g., 'a.b.c' */
+        if (next == OP_GETFIELD)
+          SET_OPCODE(code[i], OP_GETFIELD2);
+        break;
+      default: break;
+    }
+  }
+}
+
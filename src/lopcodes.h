@@ -29,60 +29,60 @@ isJ                           sJ (signed)(25)            |   Op(7)     |
 ===========================================================================*/
 
 
-// ָģʽ
-// iABCޣ48λA28ηܴ洢2568λB8λC1λ21ηܴ洢2k
-// iABCõָģʽ
+// 指令模式
+// iABC参数上限：4个，8位的A（2的8次方即最多能存储256个数），8位的B，8位的C，1位（2的1次方即最多能存储2个数）的k
+// iABC是最常用的指令模式
 // 
-// iABxޣ28λA17λ޷ŵBxBx217ηܴ洢131072
+// iABx参数上限：2个，8位的A，17位无符号的Bx（Bx，2的17次方即最多能存储131072个数）
 // 
-// iAsBxޣ28λA17λзŵBxsBx217ηܴ洢131072
+// iAsBx参数上限：2个，8位的A，17位有符号的Bx（sBx，2的17次方即最多能存储131072个数）
 // 
-// iAxޣ125λ޷ŵAxAx225ηܴ洢33554432
+// iAx参数上限：1个，25位无符号的Ax（Ax，2的25次方即最多能存储33554432个数）
 // 
-// isJޣ125λзŵsJsJ225ηܴ洢33554432
-// ĿǰΨһʹøָģʽֻתָOP_JMPԸָģʽ'isJ''sJ'ĸJ(Jumpת)
-// Ϊ˸ֱ۵ָ֪ģʽӦת
+// isJ参数上限：1个，25位有符号的sJ（sJ，2的25次方即最多能存储33554432个数）
+// 目前，唯一使用该指令模式的只有跳转指令OP_JMP；所以该指令模式名字'isJ'及参数'sJ'都带有字母‘J’(Jump，跳转)，
+// 就是为了更加直观地知道这个指令模式对应的是跳转功能
 enum OpMode {iABC, iABx, iAsBx, iAx, isJ};  /* basic instruction formats */
 
 
 /*
 ** size and position of opcode arguments.
 */
-// CС8λ
+// C参数大小8位
 #define SIZE_C		8
-// BС8λ
+// B参数大小8位
 #define SIZE_B		8
-// Bx17λ
+// Bx17位
 #define SIZE_Bx		(SIZE_C + SIZE_B + 1)
-// AС8λ
+// A参数大小8位
 #define SIZE_A		8
-// AxС25λ
+// Ax参数大小25位
 #define SIZE_Ax		(SIZE_Bx + SIZE_A)
-// sJС25λ
+// sJ参数大小25位
 #define SIZE_sJ		(SIZE_Bx + SIZE_A)
 
-// ָ
+// 指令长度
 #define SIZE_OP		7
 
-// ָʼλ
+// 指令起始位置
 #define POS_OP		0
 
-// Aʼλã7
+// A参数起始位置，7
 #define POS_A		(POS_OP + SIZE_OP)
-// kʼλã15
+// k参数起始位置，15
 #define POS_k		(POS_A + SIZE_A)
-// Bʼλã16
+// B参数起始位置，16
 #define POS_B		(POS_k + 1)
-// Cʼλã24
+// C参数起始位置，24
 #define POS_C		(POS_B + SIZE_B)
 
-// Bxʼλã15
+// Bx参数起始位置，15
 #define POS_Bx		POS_k
 
-// Axʼλã7
+// Ax参数起始位置，7
 #define POS_Ax		POS_A
 
-// sJʼλã7
+// sJ参数起始位置，7
 #define POS_sJ		POS_A
 
 
@@ -117,70 +117,70 @@ enum OpMode {iABC, iABx, iAsBx, iAx, isJ};  /* basic instruction formats */
 #define MAXARG_sJ	MAX_INT
 #endif
 
-// luaָsJǲöƲķʽб룬һbasisֵΪ0ֵbasisֵ( ((1<<25)-1)>>1 )Ҳ16777215
-// sJʾ-1ʱôֵ-1 + 16777215 = 16777214 = 0xFFFFFEҲ˵0ʾsJСֵ-167772140x1FFFFFFʾsBxֵ33554431
+// lua指令中sJ，不是采用二进制补码的方式进行编码，它采用了一个basis值作为0值，这个basis值是( ((1<<25)-1)>>1 )也就是16777215。
+// 如果sJ表示-1时，那么它的值则是-1 + 16777215 = 16777214 = 0xFFFFFE，也就是说0表示sJ的最小值-16777214，0x1FFFFFF表示sBx的最大值33554431。
 #define OFFSET_sJ	(MAXARG_sJ >> 1)
 
 
-// Aλֵܷ
+// A位能放入最大数值
 #define MAXARG_A	((1<<SIZE_A)-1)
-// Bλֵܷ
+// B位能放入最大数值
 #define MAXARG_B	((1<<SIZE_B)-1)
-// Cλֵܷ
+// C位能放入最大数值
 #define MAXARG_C	((1<<SIZE_C)-1)
-// зCֵܷ
+// 有符号C能放入最大数值
 #define OFFSET_sC	(MAXARG_C >> 1)
 
-// intתsC
+// int转sC
 #define int2sC(i)	((i) + OFFSET_sC)
-// sCתint
+// sC转int
 #define sC2int(i)	((i) - OFFSET_sC)
 
 
 /* creates a mask with 'n' 1 bits at position 'p' */
-// һӵpλʼnλ룬ֵΪ1
+// 生成一个从第p位开始的n位掩码，掩码的值为1
 #define MASK1(n,p)	((~((~(Instruction)0)<<(n)))<<(p))
 
 /* creates a mask with 'n' 0 bits at position 'p' */
-// һӵpλʼnλ룬ֵΪ0
+// 生成一个从第p位开始的n位掩码，掩码的值为0
 #define MASK0(n,p)	(~MASK1(n,p))
 
 /*
 ** the following macros help to manipulate instructions
 */
 
-// ȡָĲ
+// 获取指令的操作码
 #define GET_OPCODE(i)	(cast(OpCode, ((i)>>POS_OP) & MASK1(SIZE_OP,0)))
-// ָĲ
+// 设置指令的操作码
 #define SET_OPCODE(i,o)	((i) = (((i)&MASK0(SIZE_OP,POS_OP)) | \
 		((cast(Instruction, o)<<POS_OP)&MASK1(SIZE_OP,POS_OP))))
 
-// ָiǷָģʽm
+// 检测指令i是否等于指令模式m
 #define checkopm(i,m)	(getOpMode(GET_OPCODE(i)) == m)
 
 
-// ȡָλõĲ
+// 获取指定位置的参数
 #define getarg(i,pos,size)	(cast_int(((i)>>(pos)) & MASK1(size,0)))
-// ָλõĲ
+// 设置指定位置的参数
 #define setarg(i,v,pos,size)	((i) = (((i)&MASK0(size,pos)) | \
                 ((cast(Instruction, v)<<pos)&MASK1(size,pos))))
 
-// ȡAֵ
+// 获取A参数的值
 #define GETARG_A(i)	getarg(i, POS_A, SIZE_A)
-// Aֵ
+// 设置A参数的值
 #define SETARG_A(i,v)	setarg(i, v, POS_A, SIZE_A)
 
-// ָǷiABCָȡBֵ
+// 检测指令是否是iABC指令，并获取B参数的值
 #define GETARG_B(i)	check_exp(checkopm(i, iABC), getarg(i, POS_B, SIZE_B))
 #define GETARG_sB(i)	sC2int(GETARG_B(i))
 #define SETARG_B(i,v)	setarg(i, v, POS_B, SIZE_B)
 
-// ָǷiABCָ, ȡCֵ
+// 检测指令是否是iABC指令, 并获取C参数的值
 #define GETARG_C(i)	check_exp(checkopm(i, iABC), getarg(i, POS_C, SIZE_C))
 #define GETARG_sC(i)	sC2int(GETARG_C(i))
 #define SETARG_C(i,v)	setarg(i, v, POS_C, SIZE_C)
 
-// Ƿ	K
+// 是否设置了	K
 #define TESTARG_k(i)	check_exp(checkopm(i, iABC), (cast_int(((i) & (1u << POS_k)))))
 #define GETARG_k(i)	check_exp(checkopm(i, iABC), getarg(i, POS_k, 1))
 #define SETARG_k(i,v)	setarg(i, v, POS_k, 1)
@@ -201,7 +201,7 @@ enum OpMode {iABC, iABx, iAsBx, iAx, isJ};  /* basic instruction formats */
 	setarg(i, cast_uint((j)+OFFSET_sJ), POS_sJ, SIZE_sJ)
 
 
-// iAbcָ
+// 创建iAbc指令
 #define CREATE_ABCk(o,a,b,c,k)	((cast(Instruction, o)<<POS_OP) \
 			| (cast(Instruction, a)<<POS_A) \
 			| (cast(Instruction, b)<<POS_B) \
@@ -212,11 +212,11 @@ enum OpMode {iABC, iABx, iAsBx, iAx, isJ};  /* basic instruction formats */
 			| (cast(Instruction, a)<<POS_A) \
 			| (cast(Instruction, bc)<<POS_Bx))
 
-// iAxָ
+// 创建iAx指令
 #define CREATE_Ax(o,a)		((cast(Instruction, o)<<POS_OP) \
 			| (cast(Instruction, a)<<POS_Ax))
 
-// isJָ
+// 创建isJ指令
 #define CREATE_sJ(o,j,k)	((cast(Instruction, o) << POS_OP) \
 			| (cast(Instruction, j) << POS_sJ) \
 			| (cast(Instruction, k) << POS_k))
@@ -230,7 +230,7 @@ enum OpMode {iABC, iABx, iAsBx, iAx, isJ};  /* basic instruction formats */
 /*
 ** invalid register that fits in 8 bits
 */
-// ҪʹüĴ
+// 不需要使用寄存器
 #define NO_REG		MAXARG_A
 
 
@@ -250,221 +250,241 @@ typedef enum {
 /*----------------------------------------------------------------------
   name		args	description
 ------------------------------------------------------------------------*/
-// iABCһĴݸֵһĴ
+// iABC，把一个寄存器的数据赋值到另一个寄存器；
 OP_MOVE,/*	A B	R[A] := R[B]					*/
-// iAsBxһ[-65536,65535]ΧڵĴ
+// iAsBx，加载一个[-65536,65535]范围内的整数到寄存器中
 OP_LOADI,/*	A sBx	R[A] := sBx					*/
-// iAsBxһ[-65536,65535]ΧڵĴУǿתΪͽз
+// iAsBx，加载一个[-65536,65535]范围内的整数到寄存器中，并强制转化为浮点数类型进行返回
 OP_LOADF,/*	A sBx	R[A] := (lua_Number)sBx				*/
-// iABxBxΪ±꣬ȡݣȻ浽AΪ±ļĴ
+// iABx，以Bx为下标，读取常量数组的数据，然后把它存到以A为下标的寄存器中
 OP_LOADK,/*	A Bx	R[A] := K[Bx]					*/
-// iAxOP_LOADKBΪ17λΧΪ[0,131071]һProtoĳ
-// һЩݴУ˺ܶ಻һ֣޷ʹOP_LOADKд
-// ʱҪʹOP_LOADKXָָһָInstructionAĴлȡK±꣬
-// ͨһָָģʽΪiAxA25λΧΪ[0,33555531]ṩԶ[0,131071]ҪֵΧ
+// iAx，上面OP_LOADK的B参数为17位二进制数，范围为[0,131071]，若一个Proto中声明的常量超过了这个数量
+// （常出现在一些数据处理分析函数中，声明了很多不一样的数字），则无法使用OP_LOADK进行处理，
+// 此时就需要使用OP_LOADKX指令。该指令从下一条指令Instruction的A寄存器中获取K数组的下标，
+// 通常下一条指令的指令模式为iAx，它的A有25位，范围为[0,33555531]，提供了远比[0,131071]要大的数值范围。
 OP_LOADKX,/*	A	R[A] := K[extra arg]				*/
-// iABCĴֵΪfalse
+// iABC，寄存器赋值为false；
 OP_LOADFALSE,/*	A	R[A] := false					*/
-// iABCĴֵΪfalsepcָ1һָ
+// iABC，寄存器赋值为false；并让pc指针加1跳过下一条指令；
 OP_LFALSESKIP,/*A	R[A] := false; pc++	(*)			*/
-// iABCĴֵΪtrue
+// iABC，寄存器赋值为true
 OP_LOADTRUE,/*	A	R[A] := true					*/
-// iABCR(A)R(A+B)ֵȫֵΪNIL
+// iABC，从R(A)到R(A+B)的值，全部赋值为NIL
 OP_LOADNIL,/*	A B	R[A], R[A+1], ..., R[A+B] := nil		*/
-// iABCupvalsжȡ±ΪBUpValueݣ뵽±ΪAļĴ
+// iABC，从upvals数组中读取下标为B的UpValue数据，并存入到下标为A的寄存器中
 OP_GETUPVAL,/*	A B	R[A] := UpValue[B]				*/
-// iABC±ΪAļĴݣд뵽upvals±ΪBԪ
+// iABC，把下标为A的寄存器的数据，写入到upvals数组中下标为B元素中
 OP_SETUPVAL,/*	A B	UpValue[B] := R[A]				*/
 
-// iABCȴupvalsжȡ±ΪBUpValueݣҪΪTableͣ
-// Ȼȡ±ΪCĳkݣҪΪstringͣԸstringΪTablekeyֵ
-// ѯValueֵ뵽±ΪAļĴ
+// iABC，首先从upvals数组中读取下标为B的UpValue数据，该数据需要为Table类型，
+// 然后读取下标为C的常量数组k里面的数据，该数据需要为string类型，以该string类型数据作为Table的key值，
+// 查询出Value值，并存入到下标为A的寄存器中
 OP_GETTABUP,/*	A B C	R[A] := UpValue[B][K[C]:shortstring]		*/
-// iABCѯTablekeyΪԪصvalueֵ
+// iABC，查询Table中key为元素的value值；
 OP_GETTABLE,/*	A B C	R[A] := R[B][R[C]]				*/
-// iABCѯTablekeyΪضԪصvalueֵ
+// iABC，查询Table中key为特定整数的元素的value值；
 OP_GETI,/*	A B C	R[A] := R[B][C]					*/
-// iABCѯTablekeyΪضַԪصvalueֵ
+// iABC，查询Table中key为特定字符串的元素的value值；
 OP_GETFIELD,/*	A B C	R[A] := R[B][K[C]:shortstring]			*/
 
-// iABCȴupvalsжȡ±ΪAUpValueݣҪΪTableͣ
-// Ȼȡ±ΪBĳkݣҪΪstringͣԸstringΪTablekeyֵ
-// ѯvalueákֵCΪ±꣬ӳ߼Ĵжȡݣֵvalue
+// iABC，首先从upvals数组中读取下标为A的UpValue数据，该数据需要为Table类型，
+// 然后读取下标为B的常量数组k里面的数据，该数据需要为string类型，以该string类型数据作为Table的key值，
+// 查询出value的引用。最后根据k的值，以C为下标，从常量数组或者寄存器中读取数据，并赋值给该value。
 OP_SETTABUP,/*	A B C	UpValue[A][K[B]:shortstring] := RK(C)		*/
-// ޸TablekeyĶvalueֵ
+// 修改Table中key的对象的value值；
 OP_SETTABLE,/*	A B C	R[A][R[B]] := RK(C)				*/
-// ޸TablekeyΪضĶvalueֵ
+// 修改Table中key为特定整数的对象的value值；
 OP_SETI,/*	A B C	R[A][B] := RK(C)				*/
-// ޸TablekeyΪضַĶvalueֵ
+// 修改Table中key为特定字符串的对象的value值；
 OP_SETFIELD,/*	A B C	R[A][K[B]:shortstring] := RK(C)			*/
 
-// iABCһTableͶ󡣲BϣֵĳʼСCͲk鲿ֵĳʼС
+// iABC，创建一个Table类型对象。参数B决定哈希表部分的初始大小，参数C和参数k决定了数组部分的初始大小。
 OP_NEWTABLE,/*	A B C k	R[A] := {}					*/
 
 OP_SELF,/*	A B C	R[A+1] := R[B]; R[A] := R[B][RK(C):string]	*/
 
-// iABCһĴһзӣѽ浽һĴС
+// iABC，把一个寄存器与一个有符号整数相加，把结果存到另一个寄存器中。
 OP_ADDI,/*	A B sC	R[A] := R[B] + sC				*/
 
-// iABCӷĴ볣kеһӣѽ浽һĴУ
+// iABC，加法。寄存器与常量k数组中的一个常量相加，把结果存到另一个寄存器中；
 OP_ADDK,/*	A B C	R[A] := R[B] + K[C]:number			*/
-// 
+// 减法
 OP_SUBK,/*	A B C	R[A] := R[B] - K[C]:number			*/
-// ˷
+// 乘法
 OP_MULK,/*	A B C	R[A] := R[B] * K[C]:number			*/
-// ȡģ
+// 取模
 OP_MODK,/*	A B C	R[A] := R[B] % K[C]:number			*/
-// 
+// 幂
 OP_POWK,/*	A B C	R[A] := R[B] ^ K[C]:number			*/
-// 
+// 除法
 OP_DIVK,/*	A B C	R[A] := R[B] / K[C]:number			*/
-// 
+// 整除
 OP_IDIVK,/*	A B C	R[A] := R[B] // K[C]:number			*/
 
-// iABCλ㡣һĴһkеֽаλ㣬浽һĴС
+// iABC，位与运算。一个寄存器与一个常量k数组中的数字进行按位与运算，把运算结果存到另一个寄存器中。
 OP_BANDK,/*	A B C	R[A] := R[B] & K[C]:integer			*/
-// λ㣻
+// 位或运算；
 OP_BORK,/*	A B C	R[A] := R[B] | K[C]:integer			*/
-// λ㣻
+// 位异或运算；
 OP_BXORK,/*	A B C	R[A] := R[B] ~ K[C]:integer			*/
 
-// iABCλ㡣һĴλһֳλ浽һĴС
+// iABC，右位移运算。一个寄存器二进制右位移一个数字常量的位数，把运算结果存到另一个寄存器中。
 OP_SHRI,/*	A B sC	R[A] := R[B] >> sC				*/
-// λ
+// 左位移运算
 OP_SHLI,/*	A B sC	R[A] := sC << R[B]				*/
 
-// iABCĴֵӣѽ浽һĴС
-// ӷ
+// iABC，把两个寄存器的值相加，把结果存到另一个寄存器中。
+// 加法
 OP_ADD,/*	A B C	R[A] := R[B] + R[C]				*/
-// 
+// 减法
 OP_SUB,/*	A B C	R[A] := R[B] - R[C]				*/
-// ˷
+// 乘法
 OP_MUL,/*	A B C	R[A] := R[B] * R[C]				*/
-// ȡģ
+// 取模
 OP_MOD,/*	A B C	R[A] := R[B] % R[C]				*/
-// 
+// 幂
 OP_POW,/*	A B C	R[A] := R[B] ^ R[C]				*/
-// 
+// 除法
 OP_DIV,/*	A B C	R[A] := R[B] / R[C]				*/
-// 
+// 整除
 OP_IDIV,/*	A B C	R[A] := R[B] // R[C]				*/
 
-// iABCλ㡣2Ĵλ㣬ѽ浽3ĴУ
+// iABC，位与运算。2个寄存器做位与运算，把结果存到第3个寄存器中；
 OP_BAND,/*	A B C	R[A] := R[B] & R[C]				*/
-// λ
+// 位或运算
 OP_BOR,/*	A B C	R[A] := R[B] | R[C]				*/
-// λ
+// 位异或运算
 OP_BXOR,/*	A B C	R[A] := R[B] ~ R[C]				*/
-// λ
+// 左位移
 OP_SHL,/*	A B C	R[A] := R[B] << R[C]				*/
-// λ
+// 右位移
 OP_SHR,/*	A B C	R[A] := R[B] >> R[C]				*/
 
-// iABCLuaУԪ֧ΪĴҲ͵Ĳͬ԰ԪصOpCodeֳ3ࣺ
-// ҲҲΪĴݴ洢еջϣ
+// iABC，在Lua中，元方法支持最多两个操作数，左操作数为寄存器，右操作数根据类型的不同，可以把元方法相关的OpCode分成了以下3类：
+// 右操作数也为寄存器，数据存储在运行的栈上；
 OP_MMBIN,/*	A B C	call C metamethod over R[A] and R[B]	(*)	*/
-// ҲΪֱֱָӴ洢ֵ
+// 右操作数为直接整数，在指令中直接存储数值；
 OP_MMBINI,/*	A sB C k	call C metamethod over R[A] and sB	*/
-// ҲΪ洢ProtoĳkУ
+// 右操作数为常量，存储在Proto的常量k数组中；
 OP_MMBINK,/*	A B C k		call C metamethod over R[A] and K[B]	*/
 
-// iABCֵȡ
+// iABC，数值取负。
 OP_UNM,/*	A B	R[A] := -R[B]					*/
-// λȡ
+// 位取反。
 OP_BNOT,/*	A B	R[A] := ~R[B]					*/
-// ȡ
+// 条件取反。
 OP_NOT,/*	A B	R[A] := not R[B]				*/
-// ĳȡַ
+// 求对象的长度。常用于数组与字符串；
 OP_LEN,/*	A B	R[A] := #R[B] (length operator)			*/
 
-// iABCַƴӡӦ".."ƴַ
+// iABC，字符串拼接。对应于".."符号拼接字符串；
 OP_CONCAT,/*	A B	R[A] := R[A].. ... ..R[A + B - 1]		*/
 
 OP_CLOSE,/*	A	close all upvalues >= R[A]			*/
 OP_TBC,/*	A	mark variable A "to be closed"			*/
-// isJJģǰתת
+// isJ，J是有正负的，代表可以往前跳转或者往后跳转。
 OP_JMP,/*	sJ	pc += sJ					*/
-// iABCָвkֵжĴǷȻ߲ȣ㣬һָͨһָΪתָ
+// iABC，根据指令中参数k的数值，判断两个寄存器的数据是否满足相等或者不等，若满足，则跳过下一条指令（通常下一条指令为跳转指令）
 OP_EQ,/*	A B k	if ((R[A] == R[B]) ~= k) then pc++		*/
-// жϲСڹϵ
+// 判断操作数的小于关系；
 OP_LT,/*	A B k	if ((R[A] <  R[B]) ~= k) then pc++		*/
-// жϲСڵڹϵ
+// 判断操作数的小于等于关系；
 OP_LE,/*	A B k	if ((R[A] <= R[B]) ~= k) then pc++		*/
-// OpCodeõָеĲkkͨΪ0߼жϣOP_LT߼СڣkΪ1ʱ
-// ÷߼жϣOP_LT߼ӦľǴڵڣɴʵһOpCodeĶá
+// 上述几条OpCode，都用到了指令中的参数k，k通常为0，代表采用正逻辑进行判断，例如OP_LT正逻辑就是小于；若k为1时，
+// 代表采用反逻辑进行判断，OP_LT反逻辑对应的就是大于等于，由此实现了一条OpCode的多用。
 
-// iABCָвkֵжһĴǷ볣kеһȻ߲ȣ㣬һָ
+// iABC，根据指令中参数k的数值，判断一个寄存器是否与常量k数组中的一个常量满足相等或者不等，若满足，则跳过下一条指令；
 OP_EQK,/*	A B k	if ((R[A] == K[B]) ~= k) then pc++		*/
-// iABCָвkֵжһĴǷһзţȻ߲ȣ㣬һָ
+// iABC，根据指令中参数k的数值，判断一个寄存器是否与一个（有符号）数字满足相等或者不等，若满足，则跳过下一条指令；
 OP_EQI,/*	A sB k	if ((R[A] == sB) ~= k) then pc++		*/
-// жϲСڹϵ
+// 判断操作数的小于关系；
 OP_LTI,/*	A sB k	if ((R[A] < sB) ~= k) then pc++			*/
-// жϲСڵڹϵ
+// 判断操作数的小于等于关系；
 OP_LEI,/*	A sB k	if ((R[A] <= sB) ~= k) then pc++		*/
-// жϲĴڹϵ
+// 判断操作数的大于关系；
 OP_GTI,/*	A sB k	if ((R[A] > sB) ~= k) then pc++			*/
-// жϲĴڵڹϵ
+// 判断操作数的大于等于关系；
 OP_GEI,/*	A sB k	if ((R[A] >= sB) ~= k) then pc++		*/
 
-// iABCָkֵжһĴǷΪ٣㣬һָ
+// iABC，根据指令参数k的值，判断一个寄存器是否为真或假，若满足，则跳过下一条指令。
 OP_TEST,/*	A k	if (not R[A] == k) then pc++			*/
-// iABCָkֵжһĴǷΪ٣㣬һָѸüĴֵֵһĴ
-// OP_TESTͬǣOP_TESTSETж븳ֵͬʱڵıʽ
+// iABC，根据指令参数k的值，判断一个寄存器是否为真或假，若满足，则跳过下一条指令；否则把该寄存器的值赋值给另一个寄存器。
+// 与OP_TEST不同的是，OP_TESTSET用于判断与赋值同时存在的表达式中
 OP_TESTSET,/*	A B k	if (not R[B] == k) then pc++ else R[A] := R[B] (*) */
 
-// iABCͨã˵ǶAĴд洢ĺеãBCֵ
+// iABC，普通函数调用，含义简单来说就是对A寄存器中存储的函数进行调用，参数B决定参数数量，参数C决定返回值数量。
 OP_CALL,/*	A B C	R[A], ... ,R[A+C-2] := R[A](R[A+1], ... ,R[A+B-1]) */
-// βáOP_CALLͬOP_TAILCALLڵúʱ򣬲µĶջϢǻḴõǰջ֡
-// ڴڴݹõһЩʵУβõķʽɱ⺯öջ
-// ҪβãҪ̵ҪúһΪ¸ʽreturn XXX(params...)
-// XXXΪҪβõĺ
+// 函数尾调用。与OP_CALL不同，OP_TAILCALL在调用函数的时候，不会插入新的堆栈信息，而是会复用当前的栈帧，
+// 在存在大量函数递归调用的一些程序实现中，用尾调用的方式可避免函数调用堆栈溢出。
+// 不过函数调用要触发尾调用，需要先满足苛刻的条件，需要该函数最后一句为以下格式：return XXX(params...)。
+// 其中XXX即为要触发尾调用的函数。
 OP_TAILCALL,/*	A B C k	return R[A](R[A+1], ... ,R[A+B-1])		*/
 
-// iABCַ֧ǳķֵ
+// iABC，可以支持非常多数量的返回值。
 OP_RETURN,/*	A B C k	return R[A], ... ,R[A+B-2]	(see note)	*/
-// ûзֵ
+// 函数没有返回值；
 OP_RETURN0,/*		return						*/
-// ֻһֵ
+// 函数只有一个返回值；
 OP_RETURN1,/*	A	return R[A]					*/
 
-// iABXѭ߼ִСִѭڵOpCodeѭ1ȻתѭʼģжǷҪһֵѭִС
+// iABX，循环体逻辑执行。有序执行循环内的其它OpCode，并在最后让循环次数减1，然后重新跳转回循环开始的，判断是否需要进入下一轮的循环执行。
 OP_FORLOOP,/*	A Bx	update counters; if loop continues then pc-=Bx; */
-// iABXѭϢ׼ڵôOpCodeǰջҪǰ˳úѭƱյֵ
-// OP_FORPREP󣬻ݶջЩϢΪѭúü㻷رǰҪѭĴ
-// жǷǴЧķѭ
+// iABX，循环信息准备。在调用此OpCode前，堆栈上面需要先提前按顺序放置好循环控制变量、终点值，步长。
+// 调用OP_FORPREP后，会根据堆栈上面的这些信息，为接下来的循环设置好计算环境，特别是提前计算出需要循环的次数，
+// 判断是否是次数有效的非无限死循环。
 OP_FORPREP,/*	A Bx	<check values and prepare counters>;
                         if not to run then pc+=Bx+1;			*/
 
-// ʽѭֵʽҪһ㡣ʽѭҪһ
-// ѭĽҲ޷ѭʼǰֵͨǵзֵ
-// ŴѭѾ
-// iABXѭϢ׼
+// 泛型形式的循环比起数值形式要复杂一点。泛型形式的循环它需要一个迭代函数，
+// 循环的结束次数也无法在循环开始前就通过数值运算计算出来，而是当迭代函数不再有返回值，
+// 才代表循环已经结束。
+// iABX，循环信息准备；
 OP_TFORPREP,/*	A Bx	create upvalue for R[A + 3]; pc+=Bx		*/
-// iABCѭִУԤṩջ˵ĵѭı
+// iABC，循环迭代函数执行；根据预先提供在栈上了的迭代函数，计算出本轮循环的变量。
 OP_TFORCALL,/*	A C	R[A+4], ... ,R[A+3+C] := R[A](R[A+1], R[A+2]);	*/
-// iABXѭ߼ִСOP_TFORCALLķأжѭǷݣУתѭ岿ִѭڲ߼OpCode
+// iABX，循环体逻辑执行。根据上述的OP_TFORCALL的返回，判断循环迭代函数是否正常返回了数据，若有，则跳转回循环主体部分有序执行循环内部逻辑的OpCode。
 OP_TFORLOOP,/*	A Bx	if R[A+2] ~= nil then { R[A]=R[A+2]; pc -= Bx }	*/
 
-// бݵʽʽʼһTable
+// 以列表数据的形式的形式创建并初始化一个Table。
 OP_SETLIST,/*	A B C k	R[A][C+i] := R[A+i], 1 <= i <= B		*/
 
-// ݺԭʹհ
+// 根据函数原型创建闭包
 OP_CLOSURE,/*	A Bx	R[A] := closure(KPROTO[Bx])			*/
 
-// iABCɱȡֵʽΪR[A],R[A+1],...,R[A+C-2]=varargCʾõĲ
-// ںõĲбʹ˿ɱʱ"..."ںÿʹ"..."
-// OP_VARARGڴӿɱеȡֵ
+// iABC，可变参数取值。表达式为R[A],R[A+1],...,R[A+C-2]=vararg，参数C表示期望获得的参数数量。
+// 当我们在函数调用的参数列表中使用了可变参数，即函数定义时参数带有"..."，则在后续代码中每次使用"..."，
+// 都会生成OP_VARARG，用于处理从可变参数中的取值。
 OP_VARARG,/*	A C	R[A], R[A+1], ..., R[A+C-2] = vararg		*/
 
-// iABCкڵǰҪȵôOpCodeɶջ׼
-// OP_VARARGPREPѽҪõĺԼʱĲοջλãںĺ
+// iABC，所有函数在调用前需要先调用此OpCode完成堆栈准备，
+// OP_VARARGPREP会把将要调用的函数以及调用时传入的参数依次拷贝到栈顶位置，便于后续的函数操作。
 OP_VARARGPREP,/*A	(adjust vararg parameters)			*/
 
-OP_EXTRAARG/*	Ax	extra (larger) argument for previous opcode	*/
+OP_EXTRAARG,/*	Ax	extra (larger) argument for previous opcode	*/
+
+/* fused opcodes (superinstructions); see 'luaP_fuse' */
+// 融合指令：先执行第一条指令，快速路径成功时顺带执行并跳过下一条指令
+OP_MOVE2,/*	A B	R[A] := R[B]; do next OP_MOVE			*/
+OP_GETTABUPF,/*	A B C	R[A] := UpValue[B][K[C]:shortstring]; do next OP_GETFIELD */
+OP_GETFIELD2,/*	A B C	R[A] := R[B][K[C]:shortstring]; do next OP_GETFIELD */
+
+/* quickened opcodes (type-specialized at run time) */
+// 运行时类型特化的指令：观察到操作数类型稳定后由通用指令改写而来，类型不符时退回通用指令
+OP_ADDINT,/*	A B C	R[A] := R[B] + R[C] (integers)			*/
+OP_ADDFLT,/*	A B C	R[A] := R[B] + R[C] (floats)			*/
+OP_SUBINT,/*	A B C	R[A] := R[B] - R[C] (integers)			*/
+OP_SUBFLT,/*	A B C	R[A] := R[B] - R[C] (floats)			*/
+OP_MULINT,/*	A B C	R[A] := R[B] * R[C] (integers)			*/
+OP_MULFLT,/*	A B C	R[A] := R[B] * R[C] (floats)			*/
+OP_LTINT,/*	A B k	if ((R[A] <  R[B]) ~= k) then pc++ (integers)	*/
+OP_LTFLT/*	A B k	if ((R[A] <  R[B]) ~= k) then pc++ (floats)	*/
 } OpCode;
 
 
-#define NUM_OPCODES	((int)(OP_EXTRAARG) + 1)
+#define NUM_OPCODES	((int)(OP_LTFLT) + 1)
+
+/* number of opcodes that can appear in precompiled chunks */
+#define NUM_BASEOPCODES	((int)(OP_EXTRAARG) + 1)
 
 
 
@@ -519,6 +539,20 @@ OP_EXTRAARG/*	Ax	extra (larger) argument for previous opcode	*/
   original operand was a float. (It must be corrected in case of
   metamethods.)
 
+  (*) Fused opcodes are created only by 'luaP_fuse', never by the code
+  generator. Each one does the work of its basic opcode and then, when
+  no hooks are active and the next instruction can be done in its fast
+  path, does that next instruction too and skips it. Otherwise the next
+  instruction runs by itself. So the next instruction is kept in place,
+  line information and jumps into it are not affected, and dumps save
+  only basic opcodes.
+
+  (*) Quickened opcodes replace OP_ADD, OP_SUB, OP_MUL and OP_LT in
+  place once they run with two integer or two float operands. They
+  check that the operands still have those types; if not, they turn
+  the instruction back into its generic opcode and let it do the work.
+  After a few of these deoptimizations, the instruction stays generic.
+
 ===========================================================================*/
 
 
@@ -532,28 +566,28 @@ OP_EXTRAARG/*	Ax	extra (larger) argument for previous opcode	*/
 ** bit 7: instruction is an MM instruction (call a metamethod)
 */
 /*
-** ָԵ
-** λ0-2ָ{iABC, iABx, iAsBx, iAx, isJ}
-** λ3ǷָֵR(A)
-** λ4Ƿָһָ϶ת
-** λ5Ƿʹǰһָõջֵ B == 0 ʱ 
-** λ6ǷΪָ L->topCΪ0ʱ
-** λ7ָMMָԪ
+** 指令属性的掩码
+** 位0-2：指令的类型{iABC, iABx, iAsBx, iAx, isJ}
+** 位3：是否有这个指令赋值给R(A)
+** 位4：是否是条件指令，下一个指令肯定是跳转
+** 位5：是否使用前一条指令设置的栈顶值（当 B == 0 时） 
+** 位6：是否为下条指令设置 L->top（当操作数C为0时）
+** 位7：指令是MM指令（调用元方法）
 */
 
 LUAI_DDEC(const lu_byte luaP_opmodes[NUM_OPCODES];)
 
-// ȡָ
+// 获取指令的类型
 #define getOpMode(m)	(cast(enum OpMode, luaP_opmodes[m] & 7))
-// ָAĴֵ
+// 检查指令会给A寄存器赋值
 #define testAMode(m)	(luaP_opmodes[m] & (1 << 3))
-// Ƿָһָ϶ת
+// 检查是否是条件指令，下一个指令肯定是跳转
 #define testTMode(m)	(luaP_opmodes[m] & (1 << 4))
-// Ƿʹǰһָõջֵ B == 0 ʱ
+// 检查是否使用前一条指令设置的栈顶值（当 B == 0 时）
 #define testITMode(m)	(luaP_opmodes[m] & (1 << 5))
-// ǷΪָ L->topCΪ0ʱ
+// 检查是否为下条指令设置 L->top（当操作数C为0时）
 #define testOTMode(m)	(luaP_opmodes[m] & (1 << 6))
-// ָMMָԪ
+// 检查指令是MM指令（调用元方法）
 #define testMMMode(m)	(luaP_opmodes[m] & (1 << 7))
 
 /* "out top" (set top for next instruction) */
@@ -564,16 +598,31 @@ LUAI_DDEC(const lu_byte luaP_opmodes[NUM_OPCODES];)
 /* "in top" (uses top from previous instruction) */
 #define isIT(i)		(testITMode(GET_OPCODE(i)) && GETARG_B(i) == 0)
 
-// mm:ָMMָԪ
-// ot:ǷΪָ L->topCΪ0ʱ
-// it:Ƿʹǰһָõջֵ B == 0 ʱ 
-// t:Ƿָһָ϶ת
-// a:ǷָֵR(A)
-// m:ָ{iABC, iABx, iAsBx, iAx, isJ}
+// mm:指令是MM指令（调用元方法）
+// ot:是否为下条指令设置 L->top（当操作数C为0时）
+// it:是否使用前一条指令设置的栈顶值（当 B == 0 时） 
+// t:是否是条件指令，下一个指令肯定是跳转
+// a:是否有这个指令赋值给R(A)
+// m:指令的类型{iABC, iABx, iAsBx, iAx, isJ}
 #define opmode(mm,ot,it,t,a,m)  \
     (((mm) << 7) | ((ot) << 6) | ((it) << 5) | ((t) << 4) | ((a) << 3) | (m))
 
 
+LUAI_DDEC(const lu_byte luaP_opbase[NUM_OPCODES - NUM_BASEOPCODES];)
+
+/*
+** basic opcode of an opcode (the first part of a fused opcode, the
+** generic opcode of a quickened one)
+*/
+#define getbaseop(o)  \
+	((o) < NUM_BASEOPCODES ? (o) \
+                               : cast(OpCode, luaP_opbase[(o) - NUM_BASEOPCODES]))
+
+#define GET_BASEOPCODE(i)	getbaseop(GET_OPCODE(i))
+
+LUAI_FUNC void luaP_fuse (Instruction *code, int n);
+
+
 /* number of list items to accumulate before a SETLIST instruction */
 #define LFIELDS_PER_FLUSH	50
 
@@ -96,6 +96,17 @@ static const char *const opnames[] = {
   "VARARG",
   "VARARGPREP",
   "EXTRAARG",
+  "MOVE2",
+  "GETTABUPF",
+  "GETFIELD2",
+  "ADDINT",
+  "ADDFLT",
+  "SUBINT",
+  "SUBFLT",
+  "MULINT",
+  "MULFLT",
+  "LTINT",
+  "LTFLT",
   NULL
 };
 
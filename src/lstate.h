@@ -172,9 +172,30 @@ typedef struct stringtable {
   int nuse;  /* number of elements */
   // size表示stringtable结构内部的hash数组的⼤⼩
   int size;
+  // 渐进式rehash：调整大小时旧的散列桶数组，逐步迁移到hash中，迁移完成后释放
+  TString **ohash;  /* old array while resizing (NULL if not resizing) */
+  int osize;  /* size of 'ohash' */
+  // ohash中下标小于rehashidx的桶都已经迁移
+  int rehashidx;  /* buckets of 'ohash' before this one were moved */
 } stringtable;
 
 
+/*
+** Card tables of large tables (see 'luaC_newcards'), indexed by the
+** address of the table with open addressing and linear probing.
+*/
+typedef struct CardEntry {
+  Table *t;  /* NULL for a free entry */
+  lu_byte *cards;
+} CardEntry;
+
+typedef struct cardmap {
+  CardEntry *e;
+  int nuse;  /* number of entries in use */
+  int size;  /* size of 'e' (zero or a power of 2) */
+} cardmap;
+
+
 /*
 ** Information about a call.
 ** About union 'u':
@@ -312,8 +333,14 @@ typedef struct global_State {
   // 然后下轮GC最终还是会回来这个stepgenfull函数，重复该流程，直到新一轮的完全增量式算法标记的数量小于8分之1，
   // 才会让分代式算法恢复回部分执行模式。
   lu_mem lastatomic;  /* see function 'genstep' in file 'lgc.c' */
+  // 本轮GC预清理还能做多少工作量，用完就不再开始新一轮
+  l_mem gcprecleanwork;  /* work precleaning may still do in this cycle */
+  // 预清理每轮GC最多做多少工作量（堆大小的倍数），0表示不预清理
+  int gcpreclean;  /* maximum precleaning work, in heap sizes */
   // 字符串hashtable，算是二级缓存
   stringtable strt;  /* hash table for strings */
+  // 大表的卡表
+  cardmap cards;  /* card tables of large tables */
   // 全局注册表
   // LUA_RIDX_MAINTHREAD(1-1=0)：指向 主线程
   // LUA_RIDX_GLOBALS(2-1=1)：存储全局变量
@@ -344,6 +371,10 @@ typedef struct global_State {
   lu_byte gcstp;  /* control whether GC is running */
   // 是否是GC紧急收集
   lu_byte gcemergency;  /* true if this is an emergency collection */
+  // 本轮GC是否已经在扫描阶段开始预清理grayagain链表
+  lu_byte gcprecleaned;  /* precleaning started in this cycle? */
+  // 本轮预清理中弱键表是否标记了新的值
+  lu_byte gcephmarked;  /* ephemerons marked values in this round? */
   // GC暂停倍数，这个值决定了在垃圾回收完成之后，在启动下一次回收之前可以“放松”多少。
   // 例如，如果pause是200，意味着当内存使用量达到上一次GC预估值(g->GCestimate)的 200% 时，下一次 GC 循环才会启动。
   lu_byte gcpause;  /* size of pause between successive GCs */
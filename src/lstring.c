@@ -40,16 +40,37 @@ int luaS_eqlngstr (TString *a, TString *b) {
 }
 
 
-// ַϣ
+/*
+** Hashing goes four bytes at a time: each 32-bit word (read with
+** 'memcpy', so the string needs no alignment) is mixed into 'h' by a
+** xor, a rotation and a multiplication by an odd constant, which is a
+** bijection on 'h' for each word. As the string table uses the low
+** bits of the hash, the high half is then folded into the low half;
+** the last (up to three) bytes use the original byte-wise step. As
+** before, the hash starts from the seed, so collisions depend on it.
+** Word values depend on the byte order of the machine, which is fine
+** as hashes are never saved.
+*/
+#define HASHMUL		0x9E3779B1u
+#define rotl32(x,n)	(((x) << (n)) | (((x) & 0xffffffffu) >> (32 - (n))))
+
+// 字符串哈希计算，每次处理4个字节
 unsigned int luaS_hash (const char *str, size_t l, unsigned int seed) {
   unsigned int h = seed ^ cast_uint(l);
+  for (; l >= 4; l -= 4, str += 4) {
+    l_uint32 w;
+    memcpy(&w, str, 4);
+    h ^= cast_uint(w);
+    h = rotl32(h, 13) * HASHMUL;
+  }
+  h ^= h >> 16;  /* products mix upwards; bring high bits down */
   for (; l > 0; l--)
     h ^= ((h<<5) + (h>>2) + cast_byte(str[l - 1]));
   return h;
 }
 
 
-// 㳤ַĹϣ
+// 计算长字符串的哈希
 unsigned int luaS_hashlongstr (TString *ts) {
   lua_assert(ts->tt == LUA_VLNGSTR);
   if (ts->extra == 0) {  /* no hash? */
@@ -61,21 +82,51 @@ unsigned int luaS_hashlongstr (TString *ts) {
 }
 
 
-static void tablerehash (TString **vect, int osize, int nsize) {
-  int i;
-  for (i = osize; i < nsize; i++)  /* clear new elements */
-    vect[i] = NULL;
-  for (i = 0; i < osize; i++) {  /* rehash old part of the array */
-    TString *p = vect[i];
-    vect[i] = NULL;
+/*
+** The string table is resized incrementally: 'luaS_resize' allocates
+** the new array and keeps the old one in 'ohash'; then each call to
+** 'internshrstr' moves REHASHSTEP buckets of the old array to the new
+** one, until the old array is empty and can be freed. A string lives
+** in the old array iff its bucket there was not moved yet, so lookups,
+** insertions and removals use one chain, given by 'bucketof'. As the
+** table grows when 'nuse' reaches 'size', the old array is gone long
+** before the next resize; otherwise that resize finishes the move.
+*/
+#if !defined(REHASHSTEP)
+#define REHASHSTEP	16
+#endif
+
+
+static TString **bucketof (stringtable *tb, unsigned int h) {
+  if (tb->ohash != NULL) {  /* resizing? */
+    int i = lmod(h, tb->osize);
+    if (i >= tb->rehashidx)  /* bucket not moved yet? */
+      return &tb->ohash[i];
+  }
+  return &tb->hash[lmod(h, tb->size)];
+}
+
+
+/*
+** Move 'n' buckets of the old array to the new one; free the old array
+** when it is empty.
+*/
+static void rehashstep (lua_State *L, stringtable *tb, int n) {
+  for (; n > 0 && tb->rehashidx < tb->osize; n--) {
+    TString *p = tb->ohash[tb->rehashidx++];
     while (p) {  /* for each string in the list */
       TString *hnext = p->u.hnext;  /* save next */
-      unsigned int h = lmod(p->hash, nsize);  /* new position */
-      p->u.hnext = vect[h];  /* chain it into array */
-      vect[h] = p;
+      unsigned int h = lmod(p->hash, tb->size);  /* new position */
+      p->u.hnext = tb->hash[h];  /* chain it into array */
+      tb->hash[h] = p;
       p = hnext;
     }
   }
+  if (tb->rehashidx == tb->osize) {  /* moved everything? */
+    luaM_freearray(L, tb->ohash, tb->osize);
+    tb->ohash = NULL;
+    tb->osize = tb->rehashidx = 0;
+  }
 }
 
 
@@ -86,22 +137,20 @@ static void tablerehash (TString **vect, int osize, int nsize) {
 */
 void luaS_resize (lua_State *L, int nsize) {
   stringtable *tb = &G(L)->strt;
-  int osize = tb->size;
   TString **newvect;
-  if (nsize < osize)  /* shrinking table? */
-    tablerehash(tb->hash, osize, nsize);  /* depopulate shrinking part */
-  newvect = luaM_reallocvector(L, tb->hash, osize, nsize, TString*);
-  if (l_unlikely(newvect == NULL)) {  /* reallocation failed? */
-    if (nsize < osize)  /* was it shrinking table? */
-      tablerehash(tb->hash, nsize, osize);  /* restore to original size */
-    /* leave table as it was */
-  }
-  else {  /* allocation succeeded */
-    tb->hash = newvect;
-    tb->size = nsize;
-    if (nsize > osize)
-      tablerehash(newvect, osize, nsize);  /* rehash for new size */
-  }
+  int i;
+  if (tb->ohash != NULL)  /* previous resize not finished? */
+    rehashstep(L, tb, tb->osize);  /* finish it */
+  newvect = luaM_reallocvector(L, NULL, 0, nsize, TString*);
+  if (l_unlikely(newvect == NULL))  /* allocation failed? */
+    return;  /* leave table as it was */
+  for (i = 0; i < nsize; i++)
+    newvect[i] = NULL;
+  tb->ohash = tb->hash;  /* move its contents gradually */
+  tb->osize = tb->size;
+  tb->rehashidx = 0;
+  tb->hash = newvect;
+  tb->size = nsize;
 }
 
 
@@ -122,13 +171,14 @@ void luaS_clearcache (global_State *g) {
 /*
 ** Initialize the string table and the string cache
 */
-// ʼַhashtable
+// 初始化字符串hashtable
 void luaS_init (lua_State *L) {
   global_State *g = G(L);
   int i, j;
   stringtable *tb = &G(L)->strt;
   tb->hash = luaM_newvector(L, MINSTRTABSIZE, TString*);
-  tablerehash(tb->hash, 0, MINSTRTABSIZE);  /* clear array */
+  for (i = 0; i < MINSTRTABSIZE; i++)  /* clear array */
+    tb->hash[i] = NULL;
   tb->size = MINSTRTABSIZE;
   /* pre-create memory-error message */
   g->memerrmsg = luaS_newliteral(L, MEMERRMSG);
@@ -143,7 +193,7 @@ void luaS_init (lua_State *L) {
 /*
 ** creates a new string object
 */
-// ַ
+// 创建字符串
 static TString *createstrobj (lua_State *L, size_t l, int tag, unsigned int h) {
   TString *ts;
   GCObject *o;
@@ -153,7 +203,7 @@ static TString *createstrobj (lua_State *L, size_t l, int tag, unsigned int h) {
   ts = gco2ts(o);
   ts->hash = h;
   ts->extra = 0;
-  getstr(ts)[l] = '\0';  /* ending 0 */
+  ts->contents[l] = '\0';  /* ending 0 */
   return ts;
 }
 
@@ -161,14 +211,14 @@ static TString *createstrobj (lua_State *L, size_t l, int tag, unsigned int h) {
 TString *luaS_createlngstrobj (lua_State *L, size_t l) {
   TString *ts = createstrobj(L, l, LUA_VLNGSTR, G(L)->seed);
   ts->u.lnglen = l;
-  ts->shrlen = 0xFF;  /* signals that it is a long string */
+  ts->shrlen = LSTRREG;  /* signals that it is a long string */
   return ts;
 }
 
 
 void luaS_remove (lua_State *L, TString *ts) {
   stringtable *tb = &G(L)->strt;
-  TString **p = &tb->hash[lmod(ts->hash, tb->size)];
+  TString **p = bucketof(tb, ts->hash);
   while (*p != ts)  /* find previous element */
     p = &(*p)->u.hnext;
   *p = (*p)->u.hnext;  /* remove element from its list */
@@ -190,17 +240,21 @@ static void growstrtab (lua_State *L, stringtable *tb) {
 /*
 ** Checks whether short string exists and reuses it or creates a new one.
 */
-// ַпܸ
+// 创建短字符串，有可能复用
 static TString *internshrstr (lua_State *L, const char *str, size_t l) {
   TString *ts;
   global_State *g = G(L);
   stringtable *tb = &g->strt;
   unsigned int h = luaS_hash(str, l, g->seed);
-  TString **list = &tb->hash[lmod(h, tb->size)];
+  TString **list;
   lua_assert(str != NULL);  /* otherwise 'memcmp'/'memcpy' are undefined */
-  // ȷҵ
+  if (tb->ohash != NULL)  /* resizing? */
+    rehashstep(L, tb, REHASHSTEP);  /* move some more buckets */
+  list = bucketof(tb, h);
+  // 看看等否找到
   for (ts = *list; ts != NULL; ts = ts->u.hnext) {
-    if (l == ts->shrlen && (memcmp(str, getshrstr(ts), l * sizeof(char)) == 0)) {
+    if (h == ts->hash && l == ts->shrlen &&
+        (memcmp(str, getshrstr(ts), l * sizeof(char)) == 0)) {
       /* found! */
       if (isdead(g, ts))  /* dead (but not collected yet)? */
         changewhite(ts);  /* resurrect it */
@@ -208,10 +262,10 @@ static TString *internshrstr (lua_State *L, const char *str, size_t l) {
     }
   }
   /* else must create a new string */
-  // ֹ˻
+  // 防止退化成链表
   if (tb->nuse >= tb->size) {  /* need to grow string table? */
     growstrtab(L, tb);
-    list = &tb->hash[lmod(h, tb->size)];  /* rehash with new size */
+    list = bucketof(tb, h);  /* table may have changed */
   }
   ts = createstrobj(L, l, LUA_VSHRSTR, h);
   ts->shrlen = cast_byte(l);
@@ -226,7 +280,7 @@ static TString *internshrstr (lua_State *L, const char *str, size_t l) {
 /*
 ** new string (with explicit length)
 */
-// ַָȷĳ
+// 创建字符串，指定明确的长度
 TString *luaS_newlstr (lua_State *L, const char *str, size_t l) {
   if (l <= LUAI_MAXSHORTLEN)  /* short string? */
     return internshrstr(L, str, l);
@@ -241,13 +295,60 @@ TString *luaS_newlstr (lua_State *L, const char *str, size_t l) {
 }
 
 
+/*
+** Creates a string whose contents are kept by the host: 's' must have
+** a '\0' at position 'l', and the string releases it with 'falloc'
+** (if not NULL) when collected. Short strings are still interned, so
+** in that case the host's copy is released right away.
+*/
+TString *luaS_newextlstr (lua_State *L, const char *s, size_t l,
+                          lua_Alloc falloc, void *ud) {
+  if (l <= LUAI_MAXSHORTLEN) {  /* short string? */
+    TString *ts = internshrstr(L, s, l);
+    if (falloc != NULL)
+      (*falloc)(ud, cast_voidp(s), l + 1, 0);  /* not needed anymore */
+    return ts;
+  }
+  else {
+    GCObject *o = luaC_newobj(L, LUA_VLNGSTR, sizeextstr);
+    TString *ts = gco2ts(o);
+    ExtString *e;
+    ts->hash = G(L)->seed;
+    ts->extra = 0;
+    ts->shrlen = LSTRMEM;
+    ts->u.lnglen = l;
+    e = extstr(ts);
+    e->s = cast_charp(s);
+    e->falloc = falloc;
+    e->ud = ud;
+    e->owner = NULL;
+    return ts;
+  }
+}
+
+
+/*
+** Creates a long string with the 'l' bytes at 's', which are part of
+** string 'owner' and followed by a '\0'. The new string uses them in
+** place and keeps 'owner' alive.
+*/
+TString *luaS_newslice (lua_State *L, const char *s, size_t l,
+                        TString *owner) {
+  TString *ts;
+  lua_assert(l > LUAI_MAXSHORTLEN && s[l] == '\0');
+  ts = luaS_newextlstr(L, s, l, NULL, NULL);
+  extstr(ts)->owner = owner;
+  return ts;
+}
+
+
 /*
 ** Create or reuse a zero-terminated string, first checking in the
 ** cache (using the string address as a key). The cache can contain
 ** only zero-terminated strings, so it is safe to use 'strcmp' to
 ** check hits.
 */
-// ͨôַҪݳ
+// 更加通用创建字符串，不需要传递长度
 TString *luaS_new (lua_State *L, const char *str) {
   unsigned int i = point2uint(str) % STRCACHE_N;  /* hash */
   int j;
@@ -265,7 +366,7 @@ TString *luaS_new (lua_State *L, const char *str) {
 }
 
 
-// full user data
+// 创建full user data
 Udata *luaS_newudata (lua_State *L, size_t s, int nuvalue) {
   Udata *u;
   int i;
@@ -25,6 +25,9 @@
 */
 #define sizelstring(l)  (offsetof(TString, contents) + ((l) + 1) * sizeof(char))
 
+/* size of an external string */
+#define sizeextstr	(offsetof(TString, contents) + sizeof(ExtString))
+
 #define luaS_newliteral(L, s)	(luaS_newlstr(L, "" s, \
                                  (sizeof(s)/sizeof(char))-1))
 
@@ -38,7 +41,7 @@
 /*
 ** equality for short strings, which are always internalized
 */
-// ַȽ
+// 短字符串比较
 #define eqshrstr(a,b)	check_exp((a)->tt == LUA_VSHRSTR, (a) == (b))
 
 
@@ -53,6 +56,10 @@ LUAI_FUNC Udata *luaS_newudata (lua_State *L, size_t s, int nuvalue);
 LUAI_FUNC TString *luaS_newlstr (lua_State *L, const char *str, size_t l);
 LUAI_FUNC TString *luaS_new (lua_State *L, const char *str);
 LUAI_FUNC TString *luaS_createlngstrobj (lua_State *L, size_t l);
+LUAI_FUNC TString *luaS_newextlstr (lua_State *L, const char *s, size_t l,
+                                    lua_Alloc falloc, void *ud);
+LUAI_FUNC TString *luaS_newslice (lua_State *L, const char *s, size_t l,
+                                  TString *owner);
 
 
 #endif
@@ -355,10 +355,25 @@ static const luaL_Reg stringmetamethods[] = {
 #define CAP_POSITION	(-2)
 
 
+/*
+** Pre-analyzed pattern (see 'getpatinfo'). 'cend' and 'cset' have an
+** entry for each position in the pattern.
+*/
+typedef struct PatInfo {
+  int firstc;  /* result of 'firstchar' for the pattern */
+  const char *locale;  /* LC_CTYPE of the bitmaps (NULL if not needed) */
+  unsigned char *cend;  /* length of single-char class (0 if malformed) */
+  unsigned char *cset;  /* 1 + index in 'sets' of class bitmap (or 0) */
+  unsigned char (*sets)[(UCHAR_MAX + 1) / CHAR_BIT];  /* class bitmaps */
+} PatInfo;
+
+
 typedef struct MatchState {
   const char *src_init;  /* init of source string */
   const char *src_end;  /* end ('\0') of source string */
   const char *p_end;  /* end ('\0') of pattern */
+  const char *p_init;  /* start of pattern analyzed in 'pi' */
+  const PatInfo *pi;  /* pattern analysis (NULL if none) */
   lua_State *L;
   int matchdepth;  /* control for recursive depth (to avoid C stack overflow) */
   unsigned char level;  /* total number of captures (finished or unfinished) */
@@ -401,6 +416,12 @@ static int capture_to_close (MatchState *ms) {
 
 
 static const char *classend (MatchState *ms, const char *p) {
+  if (ms->pi != NULL) {  /* pattern was analyzed? */
+    int l = ms->pi->cend[p - ms->p_init];
+    if (l != 0)
+      return p + l;
+    /* else malformed class; raise the error below */
+  }
   switch (*p++) {
     case L_ESC: {
       if (l_unlikely(p == ms->p_end))
@@ -475,8 +496,15 @@ static int singlematch (MatchState *ms, const char *s, const char *p,
     int c = uchar(*s);
     switch (*p) {
       case '.': return 1;  /* matches any char */
-      case L_ESC: return match_class(c, uchar(*(p+1)));
-      case '[': return matchbracketclass(c, p, ep-1);
+      case L_ESC: case '[': {
+        int k;
+        if (ms->pi != NULL && (k = ms->pi->cset[p - ms->p_init]) != 0)
+          return (ms->pi->sets[k - 1][c / CHAR_BIT] >> (c % CHAR_BIT)) & 1;
+        else if (*p == L_ESC)
+          return match_class(c, uchar(*(p+1)));
+        else
+          return matchbracketclass(c, p, ep-1);
+      }
       default:  return (uchar(*p) == c);
     }
   }
@@ -761,6 +789,8 @@ static void prepstate (MatchState *ms, lua_State *L,
   ms->src_init = s;
   ms->src_end = s + ls;
   ms->p_end = p + lp;
+  ms->p_init = p;
+  ms->pi = NULL;
 }
 
 
@@ -770,17 +800,255 @@ static void reprepstate (MatchState *ms) {
 }
 
 
+/*
+** If every match of pattern 'p' must start with a given character,
+** returns that character; otherwise returns -1. That is the case when
+** the pattern starts with a plain character (or an escaped punctuation
+** character) not followed by a quantifier that accepts zero repetitions.
+** Unanchored searches use it to skip, with 'memchr', the positions
+** where a match cannot start. A pattern starting with ')' is malformed
+** and must reach 'match' to raise its error.
+*/
+static int firstchar (const char *p, size_t lp) {
+  const char *q = p + 1;  /* position after first single char */
+  int c;
+  if (lp == 0)
+    return -1;
+  c = uchar(*p);
+  if (c == L_ESC) {
+    if (lp < 2 || isalnum(uchar(p[1])))
+      return -1;  /* a class ('%a', '%b', '%f', ...) */
+    c = uchar(p[1]);
+    q++;
+  }
+  else if (c == ')' || strchr(SPECIALS, c) != NULL)  /* (also '\0') */
+    return -1;
+  if (q < p + lp && (*q == '*' || *q == '?' || *q == '-'))
+    return -1;  /* it can match zero times */
+  return c;
+}
+
+
+/*
+** {======================================================
+** Pattern cache: the second time a pattern is used by 'find', 'match',
+** 'gmatch' or 'gsub', its analysis (its first character, where each
+** single-char class ends, and a bitmap for each class or set) is
+** stored in a table shared by the library functions, keyed by the
+** pattern string; later calls with the same (interned or equal)
+** pattern find it with one table access. The first use only notes the
+** address of the pattern in a small array of recently seen patterns,
+** so that patterns used once (e.g., built on the fly) do not pay for
+** the bitmaps nor for table insertions. The table holds at most
+** PATCACHESIZE patterns and is emptied when full. Bitmaps of classes
+** such as '%a' depend on the C locale; an analysis with such bitmaps
+** keeps the LC_CTYPE locale it was made with and is made again if the
+** locale changed (e.g., by 'os.setlocale').
+** =======================================================
+*/
+
+#if !defined(PATCACHESIZE)
+#define PATCACHESIZE	64
+#endif
+
+#define MAXCACHEDPAT	250	/* longer patterns are not cached */
+#define MAXPATSETS	32	/* maximum number of bitmaps for a pattern */
+
+#define PATCOUNT	1	/* key in the cache for number of entries */
+#define PATSEEN		2	/* key in the cache for recently seen patterns */
+
+#if !defined(PATSEENSIZE)
+#define PATSEENSIZE	64
+#endif
+
+#define SETBYTES	((UCHAR_MAX + 1) / CHAR_BIT)
+
+
+/*
+** Length of the single-char class at 'p' (as computed by 'classend'),
+** or 0 if it is malformed.
+*/
+static int classlen (const char *p, const char *p_end) {
+  const char *q = p;
+  switch (*q++) {
+    case L_ESC:
+      return (q == p_end) ? 0 : 2;
+    case '[': {
+      if (*q == '^') q++;
+      do {  /* look for a ']' */
+        if (q == p_end)
+          return 0;
+        if (*(q++) == L_ESC && q < p_end)
+          q++;  /* skip escapes (e.g. '%]') */
+      } while (*q != ']');
+      return (int)(q + 1 - p);
+    }
+    default:
+      return 1;
+  }
+}
+
+
+static void analyzepattern (PatInfo *pi, const char *p, size_t lp,
+                            int nsets) {
+  size_t i;
+  int k = 0;
+  pi->firstc = firstchar(p, lp);
+  for (i = 0; i < lp; i++) {
+    int l = classlen(p + i, p + lp);
+    pi->cend[i] = (unsigned char)l;
+    pi->cset[i] = 0;
+    if ((p[i] == L_ESC || p[i] == '[') && l != 0 && k < nsets) {
+      unsigned char *set = pi->sets[k];
+      int c;
+      memset(set, 0, SETBYTES);
+      for (c = 0; c <= UCHAR_MAX; c++) {
+        int in = (p[i] == L_ESC) ? match_class(c, uchar(p[i + 1]))
+                                 : matchbracketclass(c, p + i, p + i + l - 1);
+        if (in)
+          set[c / CHAR_BIT] |= (unsigned char)(1u << (c % CHAR_BIT));
+      }
+      pi->cset[i] = (unsigned char)++k;
+    }
+  }
+}
+
+
+/*
+** Number of positions in a pattern that start a class or set; '*ctype'
+** tells whether any of them may use a character class (such as '%a'),
+** whose bitmap depends on the locale.
+*/
+static int countsets (const char *p, size_t lp, int *ctype) {
+  size_t i;
+  int n = 0;
+  *ctype = 0;
+  for (i = 0; i < lp && n < MAXPATSETS; i++) {
+    int l;
+    if ((p[i] == L_ESC || p[i] == '[') &&
+        (l = classlen(p + i, p + lp)) != 0) {
+      int j;
+      for (j = 0; j < l - 1; j++)
+        if (p[i + j] == L_ESC && isalpha(uchar(p[i + j + 1])))
+          *ctype = 1;
+      n++;
+    }
+  }
+  return n;
+}
+
+
+/* removes all patterns from cache 't' */
+static void clearpatcache (lua_State *L, int t) {
+  lua_pushnil(L);
+  while (lua_next(L, t)) {
+    lua_pop(L, 1);  /* remove value */
+    if (lua_type(L, -1) == LUA_TSTRING) {  /* a pattern? */
+      lua_pushvalue(L, -1);
+      lua_pushnil(L);
+      lua_rawset(L, t);  /* remove entry (allowed during traversal) */
+    }
+  }
+  lua_pushinteger(L, 0);
+  lua_rawseti(L, t, PATCOUNT);
+}
+
+
+/* current LC_CTYPE locale */
+static const char *ctypelocale (void) {
+  const char *loc = setlocale(LC_CTYPE, NULL);
+  return (loc == NULL) ? "" : loc;
+}
+
+
+/* creates (and pushes) the analysis of pattern 'p' */
+static PatInfo *newpatinfo (lua_State *L, const char *p, size_t lp) {
+  int ctype;
+  int nsets = countsets(p, lp, &ctype);
+  const char *loc = ctype ? ctypelocale() : NULL;
+  size_t ll = (loc != NULL) ? strlen(loc) + 1 : 0;
+  size_t sz = sizeof(PatInfo) + (size_t)nsets * SETBYTES + 2 * lp + ll;
+  PatInfo *pi = (PatInfo *)lua_newuserdatauv(L, sz, 0);
+  pi->sets = (unsigned char (*)[SETBYTES])(pi + 1);
+  pi->cend = (unsigned char *)(pi->sets + nsets);
+  pi->cset = pi->cend + lp;
+  pi->locale = (loc != NULL) ? (char *)memcpy(pi->cset + lp, loc, ll) : NULL;
+  analyzepattern(pi, p, lp, nsets);
+  return pi;
+}
+
+
+/*
+** Pushes the analysis of pattern 'p' (argument 'arg'), getting it from
+** the cache or creating it, and returns it; for patterns too long to be
+** cached or seen for the first time, pushes nil and returns NULL. The
+** caller keeps the userdata on the stack while using it, as a nested
+** call may empty the cache.
+*/
+static const PatInfo *getpatinfo (lua_State *L, int arg,
+                                  const char *p, size_t lp) {
+  int t = lua_upvalueindex(1);
+  PatInfo *pi;
+  lua_Integer n;
+  if (lp > MAXCACHEDPAT) {
+    lua_pushnil(L);
+    return NULL;
+  }
+  lua_pushvalue(L, arg);
+  switch (lua_rawget(L, t)) {
+    case LUA_TUSERDATA: {  /* already analyzed? */
+      pi = (PatInfo *)lua_touserdata(L, -1);
+      if (pi->locale == NULL || strcmp(pi->locale, ctypelocale()) == 0)
+        return pi;
+      /* else locale changed; analyze it again */
+      lua_pop(L, 1);
+      break;
+    }
+    default: {  /* not in the cache */
+      const char **seen;
+      lua_rawgeti(L, t, PATSEEN);
+      seen = (const char **)lua_touserdata(L, -1);
+      lua_pop(L, 2);  /* remove array and nil */
+      seen += (size_t)p / sizeof(void *) % PATSEENSIZE;
+      if (*seen != p) {  /* not seen recently? */
+        *seen = p;  /* only note it */
+        lua_pushnil(L);
+        return NULL;
+      }
+      lua_rawgeti(L, t, PATCOUNT);
+      n = lua_tointeger(L, -1);
+      lua_pop(L, 1);
+      if (n >= PATCACHESIZE) {  /* cache full? */
+        clearpatcache(L, t);
+        n = 0;
+      }
+      lua_pushinteger(L, n + 1);
+      lua_rawseti(L, t, PATCOUNT);  /* one more entry */
+      break;
+    }
+  }
+  pi = newpatinfo(L, p, lp);
+  lua_pushvalue(L, arg);
+  lua_pushvalue(L, -2);
+  lua_rawset(L, t);  /* cache[p] = pi */
+  return pi;
+}
+
+/* }====================================================== */
+
+
 static int str_find_aux (lua_State *L, int find) {
   size_t ls, lp;
   const char *s = luaL_checklstring(L, 1, &ls);
   const char *p = luaL_checklstring(L, 2, &lp);
   size_t init = posrelatI(luaL_optinteger(L, 3, 1), ls) - 1;
+  int plain = find && lua_toboolean(L, 4);
   if (init > ls) {  /* start after string's end? */
     luaL_pushfail(L);  /* cannot find anything */
     return 1;
   }
   /* explicit request or no special characters? */
-  if (find && (lua_toboolean(L, 4) || nospecials(p, lp))) {
+  if (plain || (find && nospecials(p, lp))) {
     /* do a plain search */
     const char *s2 = lmemfind(s + init, ls - init, p, lp);
     if (s2) {
@@ -793,12 +1061,18 @@ static int str_find_aux (lua_State *L, int find) {
     MatchState ms;
     const char *s1 = s + init;
     int anchor = (*p == '^');
-    if (anchor) {
-      p++; lp--;  /* skip anchor character */
-    }
-    prepstate(&ms, L, s, ls, p, lp);
+    const PatInfo *pi = getpatinfo(L, 2, p, lp);
+    int fc;
+    fc = anchor ? -1 : pi ? pi->firstc : firstchar(p, lp);
+    prepstate(&ms, L, s, ls, p + anchor, lp - anchor);
+    ms.pi = pi;  /* (analysis includes the anchor) */
+    ms.p_init = p;
+    p += anchor;  /* skip anchor character */
     do {
       const char *res;
+      if (fc >= 0 &&  /* skip to next possible start */
+          (s1 = (const char *)memchr(s1, fc, ms.src_end - s1)) == NULL)
+        break;
       reprepstate(&ms);
       if ((res=match(&ms, s1, p)) != NULL) {
         if (find) {
@@ -831,6 +1105,7 @@ typedef struct GMatchState {
   const char *src;  /* current position */
   const char *p;  /* pattern */
   const char *lastmatch;  /* end of last match */
+  int firstc;  /* first char of every match, or -1 (see 'firstchar') */
   MatchState ms;  /* match state */
 } GMatchState;
 
@@ -839,8 +1114,13 @@ static int gmatch_aux (lua_State *L) {
   GMatchState *gm = (GMatchState *)lua_touserdata(L, lua_upvalueindex(3));
   const char *src;
   gm->ms.L = L;
+  gm->ms.pi = (const PatInfo *)lua_touserdata(L, lua_upvalueindex(4));
   for (src = gm->src; src <= gm->ms.src_end; src++) {
     const char *e;
+    if (gm->firstc >= 0 &&  /* skip to next possible start */
+        (src = (const char *)memchr(src, gm->firstc,
+                                    gm->ms.src_end - src)) == NULL)
+      break;
     reprepstate(&gm->ms);
     if ((e = match(&gm->ms, src, gm->p)) != NULL && e != gm->lastmatch) {
       gm->src = gm->lastmatch = e;
@@ -857,13 +1137,16 @@ static int gmatch (lua_State *L) {
   const char *p = luaL_checklstring(L, 2, &lp);
   size_t init = posrelatI(luaL_optinteger(L, 3, 1), ls) - 1;
   GMatchState *gm;
+  const PatInfo *pi;
   lua_settop(L, 2);  /* keep strings on closure to avoid being collected */
   gm = (GMatchState *)lua_newuserdatauv(L, sizeof(GMatchState), 0);
+  pi = getpatinfo(L, 2, p, lp);  /* also kept on the closure */
   if (init > ls)  /* start after string's end? */
     init = ls + 1;  /* avoid overflows in 's + init' */
   prepstate(&gm->ms, L, s, ls, p, lp);
   gm->src = s + init; gm->p = p; gm->lastmatch = NULL;
-  lua_pushcclosure(L, gmatch_aux, 3);
+  gm->firstc = pi ? pi->firstc : firstchar(p, lp);
+  lua_pushcclosure(L, gmatch_aux, 4);
   return 1;
 }
 
@@ -947,20 +1230,32 @@ static int str_gsub (lua_State *L) {
   int tr = lua_type(L, 3);  /* replacement type */
   lua_Integer max_s = luaL_optinteger(L, 4, srcl + 1);  /* max replacements */
   int anchor = (*p == '^');
+  int fc;  /* first char of every match, or -1 */
   lua_Integer n = 0;  /* replacement count */
   int changed = 0;  /* change flag */
   MatchState ms;
   luaL_Buffer b;
+  const PatInfo *pi;
   luaL_argexpected(L, tr == LUA_TNUMBER || tr == LUA_TSTRING ||
                    tr == LUA_TFUNCTION || tr == LUA_TTABLE, 3,
                       "string/function/table");
+  lua_settop(L, 4);  /* keep pattern analysis at index 5 */
+  pi = getpatinfo(L, 2, p, lp);
   luaL_buffinit(L, &b);
-  if (anchor) {
-    p++; lp--;  /* skip anchor character */
-  }
-  prepstate(&ms, L, src, srcl, p, lp);
+  fc = anchor ? -1 : pi ? pi->firstc : firstchar(p, lp);
+  prepstate(&ms, L, src, srcl, p + anchor, lp - anchor);
+  ms.pi = pi;  /* (analysis includes the anchor) */
+  ms.p_init = p;
+  p += anchor;  /* skip anchor character */
   while (n < max_s) {
     const char *e;
+    if (fc >= 0) {  /* copy what cannot start a match in one go */
+      const char *next = (const char *)memchr(src, fc, ms.src_end - src);
+      if (next == NULL)
+        break;  /* no more matches; rest is added below */
+      luaL_addlstring(&b, src, next - src);
+      src = next;
+    }
     reprepstate(&ms);  /* (re)prepare state for new match */
     if ((e = match(&ms, src, p)) != NULL && e != lastmatch) {  /* match? */
       n++;
@@ -1851,24 +2146,24 @@ static const luaL_Reg strlib[] = {
 
 static void createmetatable (lua_State *L) {
   /* table to be metatable for strings */
-  // tableԪhashֿstringmetamethodsеĺ
+  // 创建table，元表，hash部分可以容stringmetamethods中的函数
   luaL_newlibtable(L, stringmetamethods);
-  // Ԫעȥ
+  // 元方法都注册进去吧
   luaL_setfuncs(L, stringmetamethods, 0);
-  // ѹַ
+  // 压入空字符串
   lua_pushliteral(L, "");  /* dummy string */
-  // 洴Ԫٴѹ
+  // 上面创建元表再次压入
   lua_pushvalue(L, -2);  /* copy table */
-  // ַԪõ
+  // 给空字符串设置元表，这里会设置到
   // G(L)->mt[ttype(obj)] = mt;
   lua_setmetatable(L, -2);  /* set table as metatable for strings */
-  // ְѿַ
+  // 又把空字符串弹出
   lua_pop(L, 1);  /* pop dummy string */
-  // stringչѹ룬ǱģδѾջ
+  // 把string扩展表压入，不是本函数创建的，上游创建已经在栈中
   lua_pushvalue(L, -2);  /* get string library */
-  // metatable.__index = stringչ
+  // 将这里的metatable.__index = string的扩展表
   lua_setfield(L, -2, "__index");  /* metatable.__index = string */
-  // Ԫ
+  // 弹出元表
   lua_pop(L, 1);  /* pop metatable */
 }
 
@@ -1876,11 +2171,18 @@ static void createmetatable (lua_State *L) {
 /*
 ** Open string library
 */
-// ʼעstringģĺĺ
+// 初始化和注册string模块的核心函数
 LUAMOD_API int luaopen_string (lua_State *L) {
-  // luaչtableҽstrlibеĺעᵽtable
-  luaL_newlib(L, strlib);
-  // stringԪҰչΪԪ__index
+  // 创建lua扩展table，并且将strlib中的函数注册到该table中
+  luaL_newlibtable(L, strlib);
+  lua_createtable(L, 2, PATCACHESIZE);  /* pattern cache */
+  lua_pushinteger(L, 0);
+  lua_rawseti(L, -2, PATCOUNT);
+  memset(lua_newuserdatauv(L, PATSEENSIZE * sizeof(char *), 0), 0,
+         PATSEENSIZE * sizeof(char *));
+  lua_rawseti(L, -2, PATSEEN);
+  luaL_setfuncs(L, strlib, 1);  /* all functions share the cache */
+  // 给string类型设置元表，并且把上面的扩展设置为元表的__index
   createmetatable(L);
   return 1;
 }
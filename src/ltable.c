@@ -100,6 +100,15 @@ static const Node dummynode_ = {
 static const TValue absentkey = {ABSTKEYCONSTANT};
 
 
+/*
+** Keep the card table of 't' (if any) up to date with the store of 'v'
+** into 'slot'. (The caller still has to check the barrier.)
+*/
+#define markcard(L,t,slot,v)  \
+  { if (l_unlikely(hascards(t)) && iscollectable(v) && \
+        iswhite(gcvalue(v))) luaC_markcard(G(L), t, slot); }
+
+
 /*
 ** Hash for integers. To allow a good hash, use the remainder operator
 ** ('%'). If integer fits as a non-negative int, compute an int
@@ -386,6 +395,48 @@ static void freehash (lua_State *L, Table *t) {
 }
 
 
+static void freecards (lua_State *L, Table *t) {
+  if (hascards(t)) {
+    unsigned int n = luaH_realasize(t) + allocsizenode(t);
+    luaC_freecards(L, t, numcards(n));
+  }
+}
+
+
+/*
+** Give a card table to 't' if it is large enough. Its entries were
+** just moved around, so a touched table must be traversed entirely
+** while any of them might be young; other tables hold no young
+** objects (or do not use cards).
+*/
+static void setcards (lua_State *L, Table *t) {
+  unsigned int n = luaH_realasize(t) + allocsizenode(t);
+  if (n >= LUAI_MINCARDSLOTS) {
+    lu_byte *cards = luaC_newcards(L, t, numcards(n));
+    if (getage(t) == G_TOUCHED1 || getage(t) == G_TOUCHED2)
+      cards[0] = CARDDIRTY;
+  }
+}
+
+
+/*
+** Index in the card table of 't' of the card covering 'slot', which
+** must be a slot of its array or hash part.
+*/
+unsigned int luaH_cardof (const Table *t, const TValue *slot) {
+  unsigned int asize = luaH_realasize(t);
+  unsigned int i;
+  if (slot >= t->array && slot < t->array + asize)  /* in array part? */
+    i = cast_uint(slot - t->array);
+  else {
+    i = cast_uint(cast(const Node *, slot) - t->node);
+    lua_assert(i < cast_uint(sizenode(t)));
+    i += asize;
+  }
+  return 1 + (i >> CARDBITS);
+}
+
+
 /*
 ** {=============================================================
 ** Rehash
@@ -576,6 +627,7 @@ void luaH_resize (lua_State *L, Table *t, unsigned int newasize,
   Table newt;  /* to keep the new hash part */
   unsigned int oldasize = setlimittosize(t);
   TValue *newarray;
+  freecards(L, t);  /* slots will move; cards are rebuilt at the end */
   /* create new hash part with appropriate size into 'newt' */
   setnodevector(L, &newt, nhsize);
   if (newasize < oldasize) {  /* will array shrink? */
@@ -604,6 +656,7 @@ void luaH_resize (lua_State *L, Table *t, unsigned int newasize,
   /* re-insert elements from old hash part into new parts */
   reinsert(L, &newt, t);  /* 'newt' now has the old hash */
   freehash(L, &newt);  /* free old hash part */
+  setcards(L, t);
 }
 
 
@@ -658,6 +711,7 @@ Table *luaH_new (lua_State *L) {
 
 // 释放lua table
 void luaH_free (lua_State *L, Table *t) {
+  freecards(L, t);
   freehash(L, t);
   luaM_freearray(L, t->array, luaH_realasize(t));
   luaM_free(L, t);
@@ -740,6 +794,8 @@ static void luaH_newkey (lua_State *L, Table *t, const TValue *key,
       }
       // 位置让出来了，置为空
       setempty(gval(mp));
+      if (hascards(t))  /* moved entry may be young */
+        luaC_markcard(G(L), t, gval(f));
     }
     else {  /* colliding node is in its own main position */
       // 确实在这个位置
@@ -754,9 +810,11 @@ static void luaH_newkey (lua_State *L, Table *t, const TValue *key,
     }
   }
   setnodekey(L, mp, key);
+  markcard(L, t, gval(mp), key);
   luaC_barrierback(L, obj2gco(t), key);
   lua_assert(isempty(gval(mp)));
   setobj2t(L, gval(mp), value);
+  markcard(L, t, gval(mp), value);
 }
 
 
@@ -835,6 +893,19 @@ const TValue *luaH_getshortstr (Table *t, TString *key) {
 }
 
 
+/*
+** Slow path of 'luaH_getshortstric': do a normal search and, when the
+** key is present, remember its node in the inline cache 'ic'.
+*/
+const TValue *luaH_getshortstrmiss (Table *t, TString *key,
+                                    unsigned int *ic) {
+  const TValue *slot = luaH_getshortstr(t, key);
+  if (slot != &absentkey)
+    *ic = cast_uint(nodefromval(slot) - t->node);
+  return slot;
+}
+
+
 // 返回t中key对应的值
 const TValue *luaH_getstr (Table *t, TString *key) {
   if (key->tt == LUA_VSHRSTR)
@@ -880,8 +951,10 @@ void luaH_finishset (lua_State *L, Table *t, const TValue *key,
                                    const TValue *slot, TValue *value) {
   if (isabstkey(slot))
     luaH_newkey(L, t, key, value);
-  else
+  else {
     setobj2t(L, cast(TValue *, slot), value);
+    markcard(L, t, slot, value);
+  }
 }
 
 
@@ -903,8 +976,10 @@ void luaH_setint (lua_State *L, Table *t, lua_Integer key, TValue *value) {
     setivalue(&k, key);
     luaH_newkey(L, t, &k, value);
   }
-  else
+  else {
     setobj2t(L, cast(TValue *, p), value);
+    markcard(L, t, p, value);
+  }
 }
 
 
@@ -10,11 +10,11 @@
 #include "lobject.h"
 
 
-// ȡָhashtableڵ
+// 获取指定索引的hashtable节点
 #define gnode(t,i)	(&(t)->node[i])
-// ȡָڵֵ
+// 获取指定节点的值
 #define gval(n)		(&(n)->i_val)
-// ȡָڵһڵ㣬ϣͻ
+// 获取指定节点的下一个节点，哈希冲突了
 #define gnext(n)	((n)->u.next)
 
 
@@ -23,7 +23,7 @@
 ** may have any of these metamethods. (First access that fails after the
 ** clearing will set the bit again.)
 */
-// ٷԪλ
+// 清除快速访问元方法的所有位
 #define invalidateTMcache(t)	((t)->flags &= ~maskflags)
 
 
@@ -39,10 +39,47 @@
 #define nodefromval(v)	cast(Node *, (v))
 
 
+/*
+** Large tables keep a card table: one byte for every CARDSIZE slots of
+** the array part followed by the hash part, plus a first byte for the
+** whole table. In generational mode, a card is set when a young object
+** is stored in one of its slots, so that a young collection traverses
+** only those slots of a touched old table (see 'luaC_markcard').
+*/
+#define CARDBITS	6
+#define CARDSIZE	(1u << CARDBITS)
+
+/* minimum number of slots for a table to have a card table */
+#if !defined(LUAI_MINCARDSLOTS)
+#define LUAI_MINCARDSLOTS	(CARDSIZE * 16)
+#endif
+
+/* size of the card table for 'n' slots */
+#define numcards(n)	(1 + (((n) + CARDSIZE - 1) >> CARDBITS))
+
+
+/*
+** Search for a short-string key through an inline cache. 'ic' keeps the
+** index of the node where the key was last found by the instruction
+** owning the cache. The cached index is only trusted after checking that
+** the node there holds exactly 'key', so the cache never needs to be
+** invalidated: a resize ('luaH_resize') or a table with a different
+** layout simply makes the check fail and falls back to a full search,
+** which refreshes the cache.
+*/
+// 内联缓存：命中时直接定位到节点，省去哈希取模和冲突链遍历
+#define luaH_getshortstric(t,key,ic) \
+  (*(ic) < cast_uint(sizenode(t)) && \
+   keyisshrstr(gnode(t, *(ic))) && keystrval(gnode(t, *(ic))) == (key) \
+     ? gval(gnode(t, *(ic))) : luaH_getshortstrmiss(t, key, ic))
+
+
 LUAI_FUNC const TValue *luaH_getint (Table *t, lua_Integer key);
 LUAI_FUNC void luaH_setint (lua_State *L, Table *t, lua_Integer key,
                                                     TValue *value);
 LUAI_FUNC const TValue *luaH_getshortstr (Table *t, TString *key);
+LUAI_FUNC const TValue *luaH_getshortstrmiss (Table *t, TString *key,
+                                                     unsigned int *ic);
 LUAI_FUNC const TValue *luaH_getstr (Table *t, TString *key);
 LUAI_FUNC const TValue *luaH_get (Table *t, const TValue *key);
 LUAI_FUNC void luaH_set (lua_State *L, Table *t, const TValue *key,
@@ -57,6 +94,7 @@ LUAI_FUNC void luaH_free (lua_State *L, Table *t);
 LUAI_FUNC int luaH_next (lua_State *L, Table *t, StkId key);
 LUAI_FUNC lua_Unsigned luaH_getn (Table *t);
 LUAI_FUNC unsigned int luaH_realasize (const Table *t);
+LUAI_FUNC unsigned int luaH_cardof (const Table *t, const TValue *slot);
 
 
 #if defined(LUA_DEBUG)
@@ -68,7 +68,7 @@ const TValue *luaT_gettm (Table *events, TMS event, TString *ename) {
 }
 
 
-// ȡԪ
+// 获取元方法
 const TValue *luaT_gettmbyobj (lua_State *L, const TValue *o, TMS event) {
   Table *mt;
   switch (ttype(o)) {
@@ -101,7 +101,7 @@ const char *luaT_objtypename (lua_State *L, const TValue *o) {
 }
 
 
-// Ԫ
+// 调用元方法
 void luaT_callTM (lua_State *L, const TValue *f, const TValue *p1,
                   const TValue *p2, const TValue *p3) {
   StkId func = L->top.p;
@@ -237,29 +237,29 @@ int luaT_callorderiTM (lua_State *L, const TValue *p1, int v2,
 }
 
 
-// OP_VARARGPREPʵ
-// ջ֣ʹÿɱܹȷʹ̶Ͷ
+// OP_VARARGPREP核心实现
+// 调整栈布局，使得可变参数函数能够正确访问固定参数和额外参数
 void luaT_adjustvarargs (lua_State *L, int nfixparams, CallInfo *ci,
                          const Proto *p) {
   int i;
-  // ʵʲ
+  // 实际参数
   int actual = cast_int(L->top.p - ci->func.p) - 1;  /* number of arguments */
-  // 
+  // 额外参数
   int nextra = actual - nfixparams;  /* number of extra arguments */
   ci->u.l.nextraargs = nextra;
   luaD_checkstack(L, p->maxstacksize + 1);
   /* copy function to the top of the stack */
-  // ci->func.pջ
+  // ci->func.p入栈
   setobjs2s(L, L->top.p++, ci->func.p);
   /* move fixed parameters to the top of the stack */
-  // ̶ջΪµciҲҪѾɵciĲΪnilGC
+  // 固定参数入栈，因为是新的ci，所以也要把旧的ci的参数置为nil，方便GC
   for (i = 1; i <= nfixparams; i++) {
     setobjs2s(L, L->top.p++, ci->func.p + i);
     setnilvalue(s2v(ci->func.p + i));  /* erase original parameter (for GC) */
   }
-  // λˣҲҪλ
+  // 上面调整位置了，这里也需要调整相对位置
   ci->func.p += actual + 1;
-  // ͬ
+  // 同上
   ci->top.p += actual + 1;
   lua_assert(L->top.p <= ci->top.p && ci->top.p <= L->stack_last.p);
 }
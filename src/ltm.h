@@ -15,59 +15,59 @@
 * WARNING: if you change the order of this enumeration,
 * grep "ORDER TM" and "ORDER OP"
 */
-// ԭö
+// 原方法类型枚举
 typedef enum {
-  // __index Ԫٷʣ
+  // __index 元方法（快速访问）
   TM_INDEX,
-  // __newindex Ԫٷʣ
+  // __newindex 元方法（快速访问）
   TM_NEWINDEX,
-  // __gc Ԫٷʣ
+  // __gc 元方法（快速访问）
   TM_GC,
-  // __mode Ԫٷʣ
+  // __mode 元方法（快速访问）
   TM_MODE,
-  // __len Ԫٷʣ
+  // __len 元方法（快速访问）
   TM_LEN,
-  // __eq ԪٷʣһпٷԵԪ
+  // __eq 元方法（快速访问，最后一个具有快速访问特性的元方法）
   TM_EQ,  /* last tag method with fast access */
-  // __add Ԫ
+  // __add 元方法
   TM_ADD,
-  // __sub Ԫ
+  // __sub 元方法
   TM_SUB,
-  // __mul Ԫ
+  // __mul 元方法
   TM_MUL,
-  // __mod Ԫ
+  // __mod 元方法
   TM_MOD,
-  // __pow Ԫ
+  // __pow 元方法
   TM_POW,
-  // __div Ԫ
+  // __div 元方法
   TM_DIV,
-  // __idiv Ԫ
+  // __idiv 元方法
   TM_IDIV,
-  // __band Ԫ
+  // __band 元方法
   TM_BAND,
-  // __bor Ԫ
+  // __bor 元方法
   TM_BOR,
-  // __bxor Ԫ
+  // __bxor 元方法
   TM_BXOR,
-  // __shl Ԫ
+  // __shl 元方法
   TM_SHL,
-  // __shr Ԫ
+  // __shr 元方法
   TM_SHR,
-  // __unm Ԫ
+  // __unm 元方法
   TM_UNM,
-  // __bnot Ԫ
+  // __bnot 元方法
   TM_BNOT,
-  // __lt Ԫ
+  // __lt 元方法
   TM_LT,
-  // __le Ԫ
+  // __le 元方法
   TM_LE,
-  // __concat Ԫ
+  // __concat 元方法
   TM_CONCAT,
-  // __call Ԫ
+  // __call 元方法
   TM_CALL,
-  // __metatable Ԫ
+  // __metatable 元方法
   TM_CLOSE,
-  // Ԫ
+  // 元方法的总数
   TM_N		/* number of elements in the enum */
 } TMS;
 
@@ -78,8 +78,8 @@ typedef enum {
 ** corresponding metamethod field. (Bit 7 of the flag is used for
 ** 'isrealasize'.)
 */
-// Ԫflagsĳʼֵ
-// 8λΪ0alimitʵʴСʶ,Ϊ1ʵʴСʶ
+// 元表flags的初始值
+// 第8位为0代表alimit是数组实际大小标识,否则如果为1代表不是数组实际大小标识
 // 00000000 00000000 00000000 00000000 ~
 // ->
 // 11111111 11111111 11111111 11111111 << 6
@@ -94,16 +94,16 @@ typedef enum {
 ** Test whether there is no tagmethod.
 ** (Because tagmethods use raw accesses, the result may be an "empty" nil.)
 */
-// ǷԪ
+// 是否有元方法
 #define notm(tm)	ttisnil(tm)
 
 
-// ȡԪ
-// һŻ,һβұеĳԪûҵʱ,ὫTableеflagsԱӦλλ,һҸñͬԪʱλѾΪ1,ôֱӷNULL
+// 获取元方法
+// 这里会做一个优化,当第一次查找表中的某个元方法并且没有找到时,会将Table中的flags成员对应的位做置位操作,这样下一次再来查找该表中同样的元方法时如果该位已经为1,那么直接返回NULL
 #define gfasttm(g,et,e) ((et) == NULL ? NULL : \
   ((et)->flags & (1u<<(e))) ? NULL : luaT_gettm(et, e, (g)->tmname[e]))
 
-// ͬϣֻһlua_State
+// 同上，只不过第一个参数是lua_State
 #define fasttm(l,et,e)	gfasttm(G(l), et, e)
 
 #define ttypename(x)	luaT_typenames_[(x) + 1]
@@ -61,12 +61,14 @@
 #if defined(LUA_USE_LINUX)
 #define LUA_USE_POSIX
 #define LUA_USE_DLOPEN		/* needs an extra library: -ldl */
+#define LUA_USE_PTHREADS	/* needs an extra library: -lpthread */
 #endif
 
 
 #if defined(LUA_USE_MACOSX)
 #define LUA_USE_POSIX
 #define LUA_USE_DLOPEN		/* MacOS does not need -ldl */
+#define LUA_USE_PTHREADS	/* MacOS does not need -lpthread */
 #endif
 
 
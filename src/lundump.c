@@ -20,7 +20,9 @@
 #include "lfunc.h"
 #include "lmem.h"
 #include "lobject.h"
+#include "lopcodes.h"
 #include "lstring.h"
+#include "ltable.h"
 #include "lundump.h"
 #include "lzio.h"
 
@@ -34,6 +36,10 @@ typedef struct {
   lua_State *L;
   ZIO *Z;
   const char *name;
+  int fixed;  /* chunk is in a fixed buffer? */
+  TString *image;  /* string holding that buffer (or NULL) */
+  int format;  /* LUAC_FORMAT or LUAC_FORMATSTR */
+  Table *strs;  /* strings of the chunk (LUAC_FORMATSTR) */
 } LoadState;
 
 
@@ -58,6 +64,52 @@ static void loadBlock (LoadState *S, void *b, size_t size) {
 #define loadVar(S,x)		loadVector(S,&x,1)
 
 
+/*
+** Whether the 'size' bytes at 'b' in a fixed buffer can be used in
+** place: when the chunk has an image, they must be inside it.
+*/
+static int inimage (LoadState *S, const char *b, size_t size) {
+  if (S->image == NULL)  /* caller keeps the buffer alive? */
+    return 1;
+  else {
+    const char *s = getstr(S->image);
+    size_t l = tsslen(S->image);
+    return (b >= s && size <= l && cast_sizet(b - s) <= l - size);
+  }
+}
+
+
+/*
+** Prototype 'f' points into the fixed buffer; it keeps its image (if
+** any) alive.
+*/
+static void setimage (LoadState *S, Proto *f) {
+  if (S->image != NULL) {
+    f->image = S->image;
+    luaC_objbarrier(S->L, f, S->image);
+  }
+}
+
+
+/*
+** In a fixed buffer, return the address of the next 'size' bytes and
+** skip them, if they are all in the current block of the reader;
+** otherwise return NULL, and the caller must copy them.
+*/
+// 固定缓冲区中直接引用数据，避免拷贝
+static const char *fixedBlock (LoadState *S, size_t size) {
+  ZIO *Z = S->Z;
+  if (S->fixed && size > 0 && Z->n >= size && inimage(S, Z->p, size)) {
+    const char *b = Z->p;
+    Z->p += size;
+    Z->n -= size;
+    return b;
+  }
+  else
+    return NULL;
+}
+
+
 static lu_byte loadByte (LoadState *S) {
   int b = zgetc(S->Z);
   if (b == EOZ)
@@ -104,6 +156,61 @@ static lua_Integer loadInteger (LoadState *S) {
 }
 
 
+/* load a value dumped as 'x - base' in zigzag encoding (see 'dumpDelta') */
+static int loadDelta (LoadState *S, int base) {
+  unsigned int z = cast_uint(loadUnsigned(S, UINT_MAX));
+  unsigned int u = (z >> 1) ^ (0u - (z & 1));
+  return cast_int(cast_uint(base) + u);
+}
+
+
+/*
+** Load the string table of a chunk in format LUAC_FORMATSTR. Long
+** strings are followed by a '\0', so in an image they are created as
+** slices of it, which use it in place and keep it alive. The table is
+** left on the stack.
+*/
+static void loadStrings (LoadState *S) {
+  lua_State *L = S->L;
+  int i;
+  int n = loadInt(S);
+  Table *t = luaH_new(L);
+  sethvalue2s(L, L->top.p, t);  /* anchor it */
+  luaD_inctop(L);
+  luaH_resize(L, t, cast_uint(n), 0);
+  S->strs = t;
+  for (i = 1; i <= n; i++) {
+    size_t size = loadSize(S);
+    const char *fb;
+    TString *ts;
+    TValue v;
+    if (size <= LUAI_MAXSHORTLEN) {  /* short string? */
+      char buff[LUAI_MAXSHORTLEN];
+      loadVector(S, buff, size);  /* load string into buffer */
+      ts = luaS_newlstr(L, buff, size);  /* create string */
+    }
+    else if (S->image != NULL &&
+             (fb = fixedBlock(S, size + 1)) != NULL) {  /* in place? */
+      if (fb[size] != '\0')
+        error(S, "bad format for string");
+      ts = luaS_newslice(L, fb, size, S->image);
+    }
+    else {  /* long string */
+      ts = luaS_createlngstrobj(L, size);  /* create string */
+      setsvalue2s(L, L->top.p, ts);  /* anchor it ('loadVector' can GC) */
+      luaD_inctop(L);
+      loadVector(S, getlngstr(ts), size + 1);  /* load it in final place */
+      L->top.p--;  /* pop string */
+      if (getlngstr(ts)[size] != '\0')
+        error(S, "bad format for string");
+    }
+    setsvalue(L, &v, ts);
+    luaH_setint(L, t, i, &v);
+    luaC_barrierback(L, obj2gco(t), &v);
+  }
+}
+
+
 /*
 ** Load a nullable string into prototype 'p'.
 */
@@ -111,6 +218,17 @@ static TString *loadStringN (LoadState *S, Proto *p) {
   lua_State *L = S->L;
   TString *ts;
   size_t size = loadSize(S);
+  if (S->format == LUAC_FORMATSTR) {  /* index in the string table? */
+    const TValue *o;
+    if (size == 0)  /* no string? */
+      return NULL;
+    o = luaH_getint(S->strs, l_castU2S(size));
+    if (!ttisstring(o))
+      error(S, "bad string index");
+    ts = tsvalue(o);
+    luaC_objbarrier(L, p, ts);
+    return ts;
+  }
   if (size == 0)  /* no string? */
     return NULL;
   else if (--size <= LUAI_MAXSHORTLEN) {  /* short string? */
@@ -146,10 +264,13 @@ static void loadCode (LoadState *S, Proto *f) {
   f->code = luaM_newvectorchecked(S->L, n, Instruction);
   f->sizecode = n;
   loadVector(S, f->code, n);
+  luaP_fuse(f->code, n);
+  luaF_newicache(S->L, f);
 }
 
 
 static void loadFunction(LoadState *S, Proto *f, TString *psource);
+static int lazyFunction (LoadState *S, Proto *f, TString *psource);
 
 
 static void loadConstants (LoadState *S, Proto *f) {
@@ -198,7 +319,8 @@ static void loadProtos (LoadState *S, Proto *f) {
   for (i = 0; i < n; i++) {
     f->p[i] = luaF_newproto(S->L);
     luaC_objbarrier(S->L, f, f->p[i]);
-    loadFunction(S, f->p[i], f->source);
+    if (!lazyFunction(S, f->p[i], f->source))
+      loadFunction(S, f->p[i], f->source);
   }
 }
 
@@ -226,16 +348,33 @@ static void loadUpvalues (LoadState *S, Proto *f) {
 
 static void loadDebug (LoadState *S, Proto *f) {
   int i, n;
+  const char *fb;
   n = loadInt(S);
-  f->lineinfo = luaM_newvectorchecked(S->L, n, ls_byte);
-  f->sizelineinfo = n;
-  loadVector(S, f->lineinfo, n);
+  if ((fb = fixedBlock(S, n)) != NULL) {  /* use it in place? */
+    f->lineinfo = cast(ls_byte *, fb);
+    f->sizelineinfo = n;
+    f->flag |= PF_FIXED;
+    setimage(S, f);
+  }
+  else {
+    f->lineinfo = luaM_newvectorchecked(S->L, n, ls_byte);
+    f->sizelineinfo = n;
+    loadVector(S, f->lineinfo, n);
+  }
   n = loadInt(S);
   f->abslineinfo = luaM_newvectorchecked(S->L, n, AbsLineInfo);
   f->sizeabslineinfo = n;
   for (i = 0; i < n; i++) {
-    f->abslineinfo[i].pc = loadInt(S);
-    f->abslineinfo[i].line = loadInt(S);
+    if (S->format == LUAC_FORMATSTR) {  /* differences? */
+      int pc = (i == 0) ? 0 : f->abslineinfo[i - 1].pc;
+      int line = (i == 0) ? f->linedefined : f->abslineinfo[i - 1].line;
+      f->abslineinfo[i].pc = loadDelta(S, pc);
+      f->abslineinfo[i].line = loadDelta(S, line);
+    }
+    else {
+      f->abslineinfo[i].pc = loadInt(S);
+      f->abslineinfo[i].line = loadInt(S);
+    }
   }
   n = loadInt(S);
   f->locvars = luaM_newvectorchecked(S->L, n, LocVar);
@@ -244,8 +383,15 @@ static void loadDebug (LoadState *S, Proto *f) {
     f->locvars[i].varname = NULL;
   for (i = 0; i < n; i++) {
     f->locvars[i].varname = loadStringN(S, f);
-    f->locvars[i].startpc = loadInt(S);
-    f->locvars[i].endpc = loadInt(S);
+    if (S->format == LUAC_FORMATSTR) {  /* differences? */
+      int pc = (i == 0) ? 0 : f->locvars[i - 1].startpc;
+      f->locvars[i].startpc = loadDelta(S, pc);
+      f->locvars[i].endpc = loadDelta(S, f->locvars[i].startpc);
+    }
+    else {
+      f->locvars[i].startpc = loadInt(S);
+      f->locvars[i].endpc = loadInt(S);
+    }
   }
   n = loadInt(S);
   if (n != 0)  /* does it have debug information? */
@@ -272,6 +418,208 @@ static void loadFunction (LoadState *S, Proto *f, TString *psource) {
 }
 
 
+/*
+** {======================================================
+** Lazy loading of nested functions
+** =======================================================
+*/
+
+/*
+** In a fixed buffer, a nested function is only scanned to find where
+** its dump ends; its prototype stays empty (PF_LAZY) and remembers that
+** part of the buffer, which 'luaU_loadlazy' loads when the function is
+** first needed. The scan works directly on the current block of the
+** reader; it fails (and the function is loaded right away) if the
+** dump does not end inside that block.
+*/
+typedef struct Scan {
+  const char *p;  /* current position */
+  const char *e;  /* end of the block */
+  int ok;  /* false if the dump went past 'e' */
+  int format;  /* format of the chunk */
+} Scan;
+
+
+static void scanSkip (Scan *sc, size_t n) {
+  if (cast_sizet(sc->e - sc->p) < n) {
+    sc->p = sc->e;
+    sc->ok = 0;
+  }
+  else
+    sc->p += n;
+}
+
+
+static int scanByte (Scan *sc) {
+  if (sc->p >= sc->e) {
+    sc->ok = 0;
+    return 0;
+  }
+  return cast_byte(*sc->p++);
+}
+
+
+static size_t scanUnsigned (Scan *sc) {
+  size_t x = 0;
+  int b;
+  do {
+    if (x >= (MAX_SIZET >> 7)) {  /* overflow? */
+      sc->ok = 0;
+      return 0;
+    }
+    b = scanByte(sc);
+    x = (x << 7) | (b & 0x7f);
+  } while (sc->ok && (b & 0x80) == 0);
+  return x;
+}
+
+
+static void scanVector (Scan *sc, size_t n, size_t size) {
+  if (n > MAX_SIZET / size)
+    sc->ok = 0;
+  else
+    scanSkip(sc, n * size);
+}
+
+
+static void scanString (Scan *sc) {
+  size_t size = scanUnsigned(sc);
+  if (size > 0 && sc->format == LUAC_FORMAT)  /* not just an index? */
+    scanSkip(sc, size - 1);
+}
+
+
+/* mirrors 'loadFunction' */
+static void scanFunction (Scan *sc) {
+  size_t i, n, nup;
+  scanString(sc);  /* source */
+  scanUnsigned(sc);  /* linedefined */
+  scanUnsigned(sc);  /* lastlinedefined */
+  scanSkip(sc, 3);  /* numparams, is_vararg, maxstacksize */
+  scanVector(sc, scanUnsigned(sc), sizeof(Instruction));  /* code */
+  n = scanUnsigned(sc);  /* constants */
+  for (i = 0; i < n && sc->ok; i++) {
+    switch (scanByte(sc)) {
+      case LUA_VNIL: case LUA_VFALSE: case LUA_VTRUE: break;
+      case LUA_VNUMFLT: scanSkip(sc, sizeof(lua_Number)); break;
+      case LUA_VNUMINT: scanSkip(sc, sizeof(lua_Integer)); break;
+      case LUA_VSHRSTR: case LUA_VLNGSTR: scanString(sc); break;
+      default: sc->ok = 0;  /* let 'loadFunction' report it */
+    }
+  }
+  nup = scanUnsigned(sc);
+  scanVector(sc, nup, 3);  /* upvalues */
+  n = scanUnsigned(sc);  /* nested functions */
+  for (i = 0; i < n && sc->ok; i++)
+    scanFunction(sc);
+  scanSkip(sc, scanUnsigned(sc));  /* lineinfo */
+  n = scanUnsigned(sc);  /* abslineinfo */
+  for (i = 0; i < n && sc->ok; i++) {
+    scanUnsigned(sc);
+    scanUnsigned(sc);
+  }
+  n = scanUnsigned(sc);  /* locvars */
+  for (i = 0; i < n && sc->ok; i++) {
+    scanString(sc);
+    scanUnsigned(sc);
+    scanUnsigned(sc);
+  }
+  if (scanUnsigned(sc) != 0) {  /* upvalue names? */
+    for (i = 0; i < nup && sc->ok; i++)
+      scanString(sc);
+  }
+}
+
+
+/*
+** Try to skip the dump of function 'f', leaving it to be loaded later.
+** In format LUAC_FORMATSTR, the empty prototype keeps the string table
+** of the chunk as its only constant.
+*/
+// 延迟加载嵌套函数：只扫描出它的dump范围
+static int lazyFunction (LoadState *S, Proto *f, TString *psource) {
+  ZIO *Z = S->Z;
+  Scan sc;
+  if (!S->fixed)
+    return 0;
+  sc.p = Z->p;
+  sc.e = Z->p + Z->n;
+  sc.ok = 1;
+  sc.format = S->format;
+  scanFunction(&sc);
+  if (!sc.ok || !inimage(S, Z->p, cast_sizet(sc.p - Z->p)))
+    return 0;
+  if (S->format == LUAC_FORMATSTR) {
+    f->k = luaM_newvectorchecked(S->L, 1, TValue);
+    f->sizek = 1;
+    sethvalue(S->L, &f->k[0], S->strs);
+    luaC_objbarrier(S->L, f, S->strs);
+  }
+  f->source = psource;  /* to load it later */
+  f->lazy = Z->p;
+  f->sizelazy = cast_sizet(sc.p - Z->p);
+  f->flag |= PF_LAZY;
+  setimage(S, f);
+  Z->p = sc.p;
+  Z->n -= f->sizelazy;
+  return 1;
+}
+
+
+static const char *noReader (lua_State *L, void *ud, size_t *size) {
+  UNUSED(L); UNUSED(ud); UNUSED(size);
+  return NULL;
+}
+
+
+static const char *chunkName (const char *name) {
+  if (name == NULL)
+    return "?";
+  else if (*name == '@' || *name == '=')
+    return name + 1;
+  else if (*name == LUA_SIGNATURE[0])
+    return "binary string";
+  else
+    return name;
+}
+
+
+/*
+** Load the nested function 'i' of 'f', left to be loaded later by a
+** load in mode 'B'. The new prototype is anchored by a closure while
+** it is loaded and only then replaces the empty one, so that after an
+** error the function can still be loaded later.
+*/
+void luaU_loadlazy (lua_State *L, Proto *f, int i) {
+  Proto *lp = f->p[i];
+  LoadState S;
+  ZIO z;
+  LClosure *cl;
+  lua_assert(lp->flag & PF_LAZY);
+  luaZ_init(L, &z, noReader, NULL);
+  z.p = lp->lazy;
+  z.n = lp->sizelazy;
+  S.L = L;
+  S.Z = &z;
+  S.name = chunkName(lp->source ? getstr(lp->source) : NULL);
+  S.fixed = 1;
+  S.image = lp->image;
+  S.format = (lp->sizek > 0) ? LUAC_FORMATSTR : LUAC_FORMAT;
+  S.strs = (lp->sizek > 0) ? hvalue(&lp->k[0]) : NULL;
+  cl = luaF_newLclosure(L, 0);
+  setclLvalue2s(L, L->top.p, cl);
+  luaD_inctop(L);
+  cl->p = luaF_newproto(L);
+  luaC_objbarrier(L, cl, cl->p);
+  loadFunction(&S, cl->p, lp->source);
+  f->p[i] = cl->p;
+  luaC_objbarrier(L, f, cl->p);
+  L->top.p--;  /* pop closure */
+}
+
+/* }====================================================== */
+
+
 static void checkliteral (LoadState *S, const char *s, const char *msg) {
   char buff[sizeof(LUA_SIGNATURE) + sizeof(LUAC_DATA)]; /* larger than both */
   size_t len = strlen(s);
@@ -294,7 +642,8 @@ static void checkHeader (LoadState *S) {
   checkliteral(S, &LUA_SIGNATURE[1], "not a binary chunk");
   if (loadByte(S) != LUAC_VERSION)
     error(S, "version mismatch");
-  if (loadByte(S) != LUAC_FORMAT)
+  S->format = loadByte(S);
+  if (S->format != LUAC_FORMAT && S->format != LUAC_FORMATSTR)
     error(S, "format mismatch");
   checkliteral(S, LUAC_DATA, "corrupted chunk");
   checksize(S, Instruction);
@@ -308,20 +657,34 @@ static void checkHeader (LoadState *S) {
 
 
 /*
-** Load precompiled chunk.
+** Load precompiled chunk. If 'fixed', the blocks returned by the reader
+** stay unchanged (see 'lua_load'), so parts of the prototypes (their
+** line information and, in format LUAC_FORMATSTR, their long strings)
+** can point directly into them instead of being copied, and nested
+** functions are loaded only when first needed. Code is always copied,
+** as the interpreter rewrites instructions in place. If the value on
+** the top of the stack is a string holding the reader's block, that
+** string is the image of the chunk: every prototype pointing into it
+** keeps it alive. Otherwise the caller keeps the blocks alive while
+** the loaded functions exist.
 */
-LClosure *luaU_undump(lua_State *L, ZIO *Z, const char *name) {
+LClosure *luaU_undump(lua_State *L, ZIO *Z, const char *name, int fixed) {
   LoadState S;
   LClosure *cl;
-  if (*name == '@' || *name == '=')
-    S.name = name + 1;
-  else if (*name == LUA_SIGNATURE[0])
-    S.name = "binary string";
-  else
-    S.name = name;
+  S.name = chunkName(name);
   S.L = L;
   S.Z = Z;
+  S.fixed = fixed;
+  S.image = NULL;
+  S.strs = NULL;
+  if (fixed && ttisstring(s2v(L->top.p - 1))) {  /* an image? */
+    S.image = tsvalue(s2v(L->top.p - 1));
+    if (!inimage(&S, Z->p, Z->n))  /* not holding the block? */
+      S.image = NULL;
+  }
   checkHeader(&S);
+  if (S.format == LUAC_FORMATSTR)
+    loadStrings(&S);  /* leaves string table on the stack */
   cl = luaF_newLclosure(L, loadByte(&S));
   setclLvalue2s(L, L->top.p, cl);
   luaD_inctop(L);
@@ -329,6 +692,10 @@ LClosure *luaU_undump(lua_State *L, ZIO *Z, const char *name) {
   luaC_objbarrier(L, cl, cl->p);
   loadFunction(&S, cl->p, NULL);
   lua_assert(cl->nupvalues == cl->p->sizeupvalues);
+  if (S.strs != NULL) {  /* remove string table from under the closure */
+    setobjs2s(L, L->top.p - 2, L->top.p - 1);
+    L->top.p--;
+  }
   luai_verifycode(L, cl->p);
   return cl;
 }
@@ -28,6 +28,7 @@
 #include "lstring.h"
 #include "ltable.h"
 #include "ltm.h"
+#include "lundump.h"
 #include "lvm.h"
 
 
@@ -836,7 +837,7 @@ void luaV_finishOp (lua_State *L) {
   CallInfo *ci = L->ci;
   StkId base = ci->func.p + 1;
   Instruction inst = *(ci->u.l.savedpc - 1);  /* interrupted instruction */
-  OpCode op = GET_OPCODE(inst);
+  OpCode op = GET_BASEOPCODE(inst);
   switch (op) {  /* finish its execution */
     case OP_MMBIN: case OP_MMBINI: case OP_MMBINK: {
       setobjs2s(L, base + GETARG_A(*(ci->u.l.savedpc - 2)), --L->top.p);
@@ -1082,6 +1083,70 @@ void luaV_finishOp (lua_State *L) {
 /* }================================================================== */
 
 
+/*
+** {==================================================================
+** Quickening: generic OP_ADD, OP_SUB, OP_MUL and OP_LT rewrite
+** themselves into a variant for integers or for floats when they see
+** two operands of that type. The variant checks its operands and, if
+** they do not match, deoptimizes: it restores the generic opcode, which
+** then does the work (and may quicken again). The inline cache of the
+** instruction counts its deoptimizations; after MAXDEOPT of them the
+** instruction keeps its generic opcode, so operands that alternate
+** types do not keep rewriting the code.
+** ===================================================================
+*/
+
+#define MAXDEOPT	4
+
+// 通用指令观察到两个操作数同为整数或同为浮点数时，原地改写为对应的特化指令
+#define quicken(v1,v2,qi,qf) {  \
+  if (*ICACHE() < MAXDEOPT) {  \
+    if (ttisinteger(v1) && ttisinteger(v2))  \
+      SET_OPCODE(*cast(Instruction *, pc - 1), qi);  \
+    else if (ttisfloat(v1) && ttisfloat(v2))  \
+      SET_OPCODE(*cast(Instruction *, pc - 1), qf);  \
+  }}
+
+// 特化指令的操作数类型不符：退回通用指令并记录退化次数
+#define deoptimize(op)	{ SET_OPCODE(*cast(Instruction *, pc - 1), op); (*ICACHE())++; }
+
+
+/*
+** Generic arithmetic operations with register operands, which can
+** quicken into 'qi' or 'qf'.
+*/
+#define op_arithq(L,iop,fop,qi,qf) {  \
+  TValue *v1 = vRB(i);  \
+  TValue *v2 = vRC(i);  \
+  quicken(v1, v2, qi, qf);  \
+  op_arith_aux(L, v1, v2, iop, fop); }
+
+
+/*
+** Quickened arithmetic operations; 'op' is the generic opcode, whose
+** code starts at label 'l'.
+*/
+#define op_arithint(L,iop,op,l) {  \
+  StkId ra = RA(i); \
+  TValue *v1 = vRB(i);  \
+  TValue *v2 = vRC(i);  \
+  if (l_likely(ttisinteger(v1) && ttisinteger(v2))) {  \
+    pc++; setivalue(s2v(ra), iop(L, ivalue(v1), ivalue(v2)));  \
+  }  \
+  else { deoptimize(op); goto l; }}
+
+#define op_arithflt(L,fop,op,l) {  \
+  StkId ra = RA(i); \
+  TValue *v1 = vRB(i);  \
+  TValue *v2 = vRC(i);  \
+  if (l_likely(ttisfloat(v1) && ttisfloat(v2))) {  \
+    pc++; setfltvalue(s2v(ra), fop(L, fltvalue(v1), fltvalue(v2)));  \
+  }  \
+  else { deoptimize(op); goto l; }}
+
+/* }================================================================== */
+
+
 /*
 ** {==================================================================
 ** Function 'luaV_execute': main interpreter loop
@@ -1106,6 +1171,24 @@ void luaV_finishOp (lua_State *L) {
 #define KC(i)	(k+GETARG_C(i))
 // 若k为1，则读取k常量数组，否则才是读取寄存器
 #define RKC(i)	((TESTARG_k(i)) ? k + GETARG_C(i) : s2v(base + GETARG_C(i)))
+// 当前指令的内联缓存('pc'已经指向下一条指令)
+#define ICACHE()	(cl->p->icache + (pc - cl->p->code - 1))
+
+
+/*
+** Second part of fused opcodes ending with an OP_GETFIELD: when there
+** are no hooks and the field is present, do the next instruction here
+** and skip it; otherwise it runs by itself.
+*/
+#define fusegetfield() {  \
+  Instruction ni = *pc;  \
+  const TValue *nslot;  \
+  lua_assert(GET_BASEOPCODE(ni) == OP_GETFIELD);  \
+  if (l_likely(!trap) &&  \
+      luaV_fastgetic(L, vRB(ni), tsvalue(KC(ni)), nslot, ICACHE() + 1)) {  \
+    setobj2s(L, RA(ni), nslot);  \
+    pc++;  \
+  }}
 
 
 
@@ -1353,7 +1436,7 @@ returning:  /* trap already set */
         TValue *rb = vRB(i);
         TValue *rc = KC(i);
         TString *key = tsvalue(rc);  /* key must be a short string */
-        if (luaV_fastget(L, rb, key, slot, luaH_getshortstr)) {
+        if (luaV_fastgetic(L, rb, key, slot, ICACHE())) {
           setobj2s(L, ra, slot);
         }
         else
@@ -1409,7 +1492,7 @@ returning:  /* trap already set */
         TValue *rb = KB(i);
         TValue *rc = RKC(i);
         TString *key = tsvalue(rb);  /* key must be a short string */
-        if (luaV_fastget(L, s2v(ra), key, slot, luaH_getshortstr)) {
+        if (luaV_fastgetic(L, s2v(ra), key, slot, ICACHE())) {
           luaV_finishfastset(L, s2v(ra), slot, rc);
         }
         else
@@ -1442,7 +1525,24 @@ returning:  /* trap already set */
         TValue *rc = RKC(i);
         TString *key = tsvalue(rc);  /* key must be a string */
         setobj2s(L, ra + 1, rb);
-        if (luaV_fastget(L, rb, key, slot, luaH_getstr)) {
+        if (ttistable(rb) && key->tt == LUA_VSHRSTR) {
+          unsigned int *ic = ICACHE();
+          const TValue *tm;
+          slot = luaH_getshortstric(hvalue(rb), key, ic);
+          if (!isempty(slot)) {
+            setobj2s(L, ra, slot);
+          }
+          /* usual object layout: method lives in the '__index' table */
+          // 对象自身没有该方法时，直接通过内联缓存查找元表__index所指向的类表
+          else if ((tm = fasttm(L, hvalue(rb)->metatable, TM_INDEX)) != NULL &&
+                   ttistable(tm) &&
+                   !isempty(slot = luaH_getshortstric(hvalue(tm), key, ic))) {
+            setobj2s(L, ra, slot);
+          }
+          else
+            Protect(luaV_finishget(L, rb, rc, ra, slot));
+        }
+        else if (luaV_fastget(L, rb, key, slot, luaH_getstr)) {
           setobj2s(L, ra, slot);
         }
         else
@@ -1516,15 +1616,18 @@ returning:  /* trap already set */
         vmbreak;
       }
       vmcase(OP_ADD) {
-        op_arith(L, l_addi, luai_numadd);
+       l_add:
+        op_arithq(L, l_addi, luai_numadd, OP_ADDINT, OP_ADDFLT);
         vmbreak;
       }
       vmcase(OP_SUB) {
-        op_arith(L, l_subi, luai_numsub);
+       l_sub:
+        op_arithq(L, l_subi, luai_numsub, OP_SUBINT, OP_SUBFLT);
         vmbreak;
       }
       vmcase(OP_MUL) {
-        op_arith(L, l_muli, luai_nummul);
+       l_mul:
+        op_arithq(L, l_muli, luai_nummul, OP_MULINT, OP_MULFLT);
         vmbreak;
       }
       vmcase(OP_MOD) {
@@ -1571,7 +1674,7 @@ returning:  /* trap already set */
         TValue *rb = vRB(i);
         TMS tm = (TMS)GETARG_C(i);
         StkId result = RA(pi);
-        lua_assert(OP_ADD <= GET_OPCODE(pi) && GET_OPCODE(pi) <= OP_SHR);
+        lua_assert(OP_ADD <= GET_BASEOPCODE(pi) && GET_BASEOPCODE(pi) <= OP_SHR);
         Protect(luaT_trybinTM(L, s2v(ra), rb, result, tm));
         vmbreak;
       }
@@ -1667,6 +1770,8 @@ returning:  /* trap already set */
         vmbreak;
       }
       vmcase(OP_LT) {
+       l_lt:
+        quicken(s2v(RA(i)), vRB(i), OP_LTINT, OP_LTFLT);
         op_order(L, l_lti, LTnum, lessthanothers);
         vmbreak;
       }
@@ -1921,14 +2026,19 @@ returning:  /* trap already set */
         for (; n > 0; n--) {
           TValue *val = s2v(ra + n);
           setobj2t(L, &h->array[last - 1], val);
+          luaC_barriertable(L, h, &h->array[last - 1], val);
           last--;
-          luaC_barrierback(L, obj2gco(h), val);
         }
         vmbreak;
       }
       vmcase(OP_CLOSURE) {
         StkId ra = RA(i);
         Proto *p = cl->p->p[GETARG_Bx(i)];
+        if (l_unlikely(p->flag & PF_LAZY)) {  /* not loaded yet? */
+          Protect(luaU_loadlazy(L, cl->p, GETARG_Bx(i)));
+          updatestack(ci);  /* stack may have changed */
+          p = cl->p->p[GETARG_Bx(i)];
+        }
         halfProtect(pushclosure(L, p, cl->upvals, base, ra));
         checkGC(L, ra + 1);
         vmbreak;
@@ -1954,6 +2064,94 @@ returning:  /* trap already set */
         lua_assert(0);
         vmbreak;
       }
+      vmcase(OP_MOVE2) {
+        StkId ra = RA(i);
+        setobjs2s(L, ra, RB(i));
+        if (l_likely(!trap)) {  /* no hooks? do the next OP_MOVE here */
+          i = *(pc++);
+          lua_assert(GET_BASEOPCODE(i) == OP_MOVE);
+          setobjs2s(L, RA(i), RB(i));
+        }
+        vmbreak;
+      }
+      vmcase(OP_GETTABUPF) {
+        StkId ra = RA(i);
+        const TValue *slot;
+        TValue *upval = cl->upvals[GETARG_B(i)]->v.p;
+        TValue *rc = KC(i);
+        TString *key = tsvalue(rc);  /* key must be a short string */
+        if (luaV_fastget(L, upval, key, slot, luaH_getshortstr)) {
+          setobj2s(L, ra, slot);
+          fusegetfield();
+        }
+        else
+          Protect(luaV_finishget(L, upval, rc, ra, slot));
+        vmbreak;
+      }
+      vmcase(OP_GETFIELD2) {
+        StkId ra = RA(i);
+        const TValue *slot;
+        TValue *rb = vRB(i);
+        TValue *rc = KC(i);
+        TString *key = tsvalue(rc);  /* key must be a short string */
+        if (luaV_fastgetic(L, rb, key, slot, ICACHE())) {
+          setobj2s(L, ra, slot);
+          fusegetfield();
+        }
+        else
+          Protect(luaV_finishget(L, rb, rc, ra, slot));
+        vmbreak;
+      }
+      vmcase(OP_ADDINT) {
+        op_arithint(L, l_addi, OP_ADD, l_add);
+        vmbreak;
+      }
+      vmcase(OP_ADDFLT) {
+        op_arithflt(L, luai_numadd, OP_ADD, l_add);
+        vmbreak;
+      }
+      vmcase(OP_SUBINT) {
+        op_arithint(L, l_subi, OP_SUB, l_sub);
+        vmbreak;
+      }
+      vmcase(OP_SUBFLT) {
+        op_arithflt(L, luai_numsub, OP_SUB, l_sub);
+        vmbreak;
+      }
+      vmcase(OP_MULINT) {
+        op_arithint(L, l_muli, OP_MUL, l_mul);
+        vmbreak;
+      }
+      vmcase(OP_MULFLT) {
+        op_arithflt(L, luai_nummul, OP_MUL, l_mul);
+        vmbreak;
+      }
+      vmcase(OP_LTINT) {
+        StkId ra = RA(i);
+        TValue *rb = vRB(i);
+        if (l_likely(ttisinteger(s2v(ra)) && ttisinteger(rb))) {
+          int cond = l_lti(ivalue(s2v(ra)), ivalue(rb));
+          docondjump();
+        }
+        else {
+          deoptimize(OP_LT);
+          goto l_lt;
+        }
+        vmbreak;
+      }
+      vmcase(OP_LTFLT) {
+        StkId ra = RA(i);
+        TValue *rb = vRB(i);
+        if (l_likely(ttisfloat(s2v(ra)) && ttisfloat(rb))) {
+          int cond = luai_numlt(fltvalue(s2v(ra)), fltvalue(rb));
+          docondjump();
+        }
+        else {
+          deoptimize(OP_LT);
+          goto l_lt;
+        }
+        vmbreak;
+      }
     }
   }
 }
@@ -82,12 +82,12 @@ typedef enum {
 ** with 'slot' pointing to an empty 't[k]' (if 't' is a table) or NULL
 ** (otherwise). 'f' is the raw get function to use.
 */
-// ŻмʵĻƣּܡ˵
-// ·tдڼkֱӷ1slotָkӦֵλá
-// ڵkڱtУ򷵻0slotָһյkλãtǱNULLtǱ
-// Ԫ飺0ʱԪ__indexԪȷδ
-// ԭʼȡʹúfʵʵĻȡ
-// ֻƿԼٲҪԪãӶŻмķٶȣرƵʱм£ܹܡ
+// 优化表中键访问的机制，旨在提高性能。具体来说：
+// 快速路径：如果表t中存在键k，则直接返回1，并将slot指向k对应的值的位置。
+// 不存在的情况：如果k不存在于表t中，则返回0，并将slot指向一个空的k位置（如果t是表）或者NULL（如果t不是表）。
+// 元方法检查：当返回0时，接下来会检查元方法（如__index元方法）来确定如何处理这种情况。
+// 原始获取函数：使用函数f来进行实际的获取操作。
+// 这种机制可以减少不必要的元方法调用，从而优化表中键的访问速度，特别是在频繁访问表中键的情况下，能够显著提高性能。
 #define luaV_fastget(L,t,k,slot,f) \
   (!ttistable(t)  \
    ? (slot = NULL, 0)  /* not a table; 'slot' is NULL and result is 0 */  \
@@ -95,6 +95,17 @@ typedef enum {
       !isempty(slot)))  /* result not empty? */
 
 
+/*
+** Special case of 'luaV_fastget' for short strings, going through the
+** inline cache 'ic' of the instruction doing the access.
+*/
+#define luaV_fastgetic(L,t,k,slot,ic) \
+  (!ttistable(t)  \
+   ? (slot = NULL, 0)  /* not a table; 'slot' is NULL and result is 0 */  \
+   : (slot = luaH_getshortstric(hvalue(t), k, ic),  \
+      !isempty(slot)))  /* result not empty? */
+
+
 /*
 ** Special case of 'luaV_fastget' for integers, inlining the fast case
 ** of 'luaH_getint'.
@@ -111,10 +122,10 @@ typedef enum {
 ** Finish a fast set operation (when fast get succeeds). In that case,
 ** 'slot' points to the place to put the value.
 */
-// ɿٻȡ󣬽пãٵغӦǲԭ
+// 经由快速获取后，进行快速设置，快速地含义应该是不触发原表
 #define luaV_finishfastset(L,t,slot,v) \
     { setobj2t(L, cast(TValue *,slot), v); \
-      luaC_barrierback(L, gcvalue(t), v); }
+      luaC_barriertable(L, hvalue(t), slot, v); }
 
 
 /*
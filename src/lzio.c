@@ -20,7 +20,7 @@
 #include "lzio.h"
 
 
-// zҷضһַ
+// 填充z，并且返回读到第一个字符
 int luaZ_fill (ZIO *z) {
   size_t size;
   lua_State *L = z->L;
@@ -36,7 +36,7 @@ int luaZ_fill (ZIO *z) {
 }
 
 
-// ZIOʼ
+// ZIO初始化
 void luaZ_init (lua_State *L, ZIO *z, lua_Reader reader, void *data) {
   z->L = L;
   z->reader = reader;
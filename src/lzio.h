@@ -17,37 +17,37 @@
 
 typedef struct Zio ZIO;
 
-// лַͶȡûо
+// 还有缓存字符就读取，没有就填充
 #define zgetc(z)  (((z)->n--)>0 ?  cast_uchar(*(z)->p++) : luaZ_fill(z))
 
 
-// token
+// token缓存
 typedef struct Mbuffer {
-  // 
+  // 缓存
   char *buffer;
-  // ǰַ
+  // 当前字符数
   size_t n;
-  // شС
+  // 缓存池大小
   size_t buffsize;
 } Mbuffer;
 
-// ʼ
+// 初始化
 #define luaZ_initbuffer(L, buff) ((buff)->buffer = NULL, (buff)->buffsize = 0)
 
-// ػ
+// 返回缓存
 #define luaZ_buffer(buff)	((buff)->buffer)
-// ػشС
+// 返回缓存池大小
 #define luaZ_sizebuffer(buff)	((buff)->buffsize)
-// صǰַ
+// 返回当前字符数
 #define luaZ_bufflen(buff)	((buff)->n)
 
-// ȥǰiַ
+// 去掉上前i个字符
 #define luaZ_buffremove(buff,i)	((buff)->n -= (i))
-// 
+// 重置
 #define luaZ_resetbuffer(buff) ((buff)->n = 0)
 
 
-// 
+// 扩容
 #define luaZ_resizebuffer(L, buff, size) \
 	((buff)->buffer = luaM_reallocvchar(L, (buff)->buffer, \
 				(buff)->buffsize, size), \
@@ -64,17 +64,17 @@ LUAI_FUNC size_t luaZ_read (ZIO* z, void *b, size_t n);	/* read next n bytes */
 
 /* --------- Private Part ------------------ */
 
-// ַȡ
+// 字符流读取器
 struct Zio {
-  // ʣɶַ
+  // 剩余可读字符
   size_t n;  /* bytes still unread */
-  // ǰȡλ
+  // 当前读取到的位置
   const char *p;  /* current position in buffer */
-  // ȡ
+  // 读取函数
   lua_Reader reader;  /* reader function */
-  // ȡû
+  // 读取函数的用户数据
   void *data;	/* additional data */
-  // ״̬
+  // 状态机
   lua_State *L;  /* Lua state (for reader) */
 };
 